@@ -0,0 +1,74 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <climits>
+#include <string>
+#include "rutas.h"
+#include "dijkstra.h"
+
+/*Microbenchmark que compara las colas de prioridad de Dijkstra: la basada en multiset (ColaPrioridad), el montículo
+  d-ario indexado (ColaPrioridadIndexada), las cubetas de Dial (ColaCubetasDial), el montículo radix (ColaRadix) y la
+  elección automática entre estas dos (ColaMinutos, la de EspacioDijkstra). Todas se usan como política del mismo
+  EspacioDijkstraCon sobre redes aleatorias con tuberías de hasta 10, 1000 y 100000 minutos, así la comparación mide
+  exactamente las operaciones que hace el algoritmo.
+  Compilar con: g++ -O2 -std=c++17 -o benchmark_cola_prioridad benchmark_cola_prioridad.cpp */
+
+/**
+ * Crea una red aleatoria con el número de centros y de tuberías por centro indicados.
+ * La semilla fija hace que todas las colas trabajen sobre la misma red.
+ */
+Rutas generarRedAleatoria(int numeroCentrosAgua, int tuberiasPorCentro, int minutosMaximo, unsigned int semilla) {
+    std::mt19937 generador(semilla);
+    std::uniform_int_distribution<int> centro(0, numeroCentrosAgua - 1);
+    std::uniform_int_distribution<int> minutos(1, minutosMaximo);
+    Rutas red(numeroCentrosAgua);
+    for (int u = 0; u < numeroCentrosAgua; ++u) {
+        red.agregarTuberia(u, (u + 1) % numeroCentrosAgua, minutos(generador)); // Anillo para que todo sea alcanzable
+        for (int k = 1; k < tuberiasPorCentro; ++k) {
+            red.agregarTuberia(u, centro(generador), minutos(generador));
+        }
+    }
+    return red;
+}
+
+/**
+ * Mide el tiempo promedio de un recorrido de Dijkstra con la cola indicada y lo imprime. La suma de las distancias
+ * alcanzables sirve de control: todas las colas deben dar la misma.
+ */
+template <typename Cola>
+void medir(const std::string& nombre, Rutas& red, int repeticiones) {
+    EspacioDijkstraCon<Cola> espacio(red.getNumeroCentrosAgua(), red.getMinutosMaximo());
+    const RedCSR& csr = red.getRedCSR();
+    long long control = 0;
+    auto inicio = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeticiones; ++i) {
+        espacio.ejecutar(csr, i % red.getNumeroCentrosAgua());
+        for (int centro : espacio.getAsentados()) {
+            control += espacio.getMinutos(centro);
+        }
+    }
+    auto fin = std::chrono::steady_clock::now();
+    double milisegundos = std::chrono::duration<double, std::milli>(fin - inicio).count() / repeticiones;
+    std::cout << "  " << nombre << ": " << milisegundos << " ms por Dijkstra (control " << control << ")" << std::endl;
+}
+
+int main() {
+    const int tuberiasPorCentro = 4;
+    for (int minutosMaximo : {10, 1000, 100000}) {
+        for (int numeroCentrosAgua : {1000, 5000, 20000}) {
+            Rutas red = generarRedAleatoria(numeroCentrosAgua, tuberiasPorCentro, minutosMaximo, 12345);
+            int repeticiones = numeroCentrosAgua <= 5000 ? 10 : 3;
+            std::cout << numeroCentrosAgua << " centros de agua, " << numeroCentrosAgua * tuberiasPorCentro << " tuberias de hasta "
+                      << minutosMaximo << " minutos:" << std::endl;
+            medir<ColaPrioridad>("ColaPrioridad (multiset)", red, repeticiones);
+            medir<ColaPrioridadIndexada<2>>("ColaPrioridadIndexada<2>", red, repeticiones);
+            medir<ColaPrioridadIndexada<4>>("ColaPrioridadIndexada<4>", red, repeticiones);
+            medir<ColaPrioridadIndexada<8>>("ColaPrioridadIndexada<8>", red, repeticiones);
+            medir<ColaCubetasDial<>>("ColaCubetasDial", red, repeticiones);
+            medir<ColaRadix<>>("ColaRadix", red, repeticiones);
+            medir<ColaMinutos<>>("ColaMinutos (automatica)", red, repeticiones);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,419 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <thread>
+#include <atomic>
+#include "rutas.h"
+#include "cola_prioridad.h"
+#include "dijkstra.h"
+#include "pool_hilos.h"
+#include "todos_origenes.h"
+#include "origen_optimo.h"
+#include "consulta_ruta.h"
+#include "generadores_red.h"
+#include "delta_stepping.h"
+#include "jerarquia_contraccion.h"
+#include "contingencia.h"
+#include "red_versionada.h"
+#include "formato_binario.h"
+#include "instrumentacion.h"
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+/*Benchmark de Dijkstra, de las consultas de ruta, del cálculo desde todos los orígenes (opción 6) y del análisis de
+  contingencias sobre redes sintéticas reproducibles. "un_origen_mapeado" repite Dijkstra leyendo la red guardada en
+  benchmark_rutas_red.bin desde memoria mapeada, sin copiarla (el archivo se borra al terminar). "consultas_concurrentes" mide Dijkstra desde los hilos del pool
+  sobre versiones fijadas de una RedVersionada mientras otro hilo cambia disponibilidades ("ediciones_concurrentes").
+  Cada medición se imprime como una línea JSON independiente para poder comparar versiones con cualquier herramienta.
+  Compilar con: g++ -O2 -std=c++17 -pthread -o benchmark_rutas benchmark_rutas.cpp   (en Windows agregar -lpsapi;
+  con -DINSTRUMENTAR se agrega por red una línea con los contadores de instrumentacion.h)
+  Uso: benchmark_rutas [--generadores cuadricula,aleatoria,libre_escala,cadena] [--min-centros 1000]
+                       [--max-centros 1000000] [--semilla 42] [--hilos 0] [--origenes 5] [--consultas 200]
+                       [--max-todos-origenes 5000] [--delta 0] [--max-jerarquia 10000] [--max-matriz 4096]
+  El generador "distrito" (red densa) no está en la lista predeterminada: usarlo con --max-centros de pocos miles.
+  Con -mavx2 (o -march=native) la matriz de distancias usa su núcleo AVX2. */
+
+/**
+ * Estructura OpcionesBenchmark
+ *
+ * Parámetros del benchmark leídos de la línea de comandos.
+ */
+struct OpcionesBenchmark {
+    std::vector<std::string> generadores = {"cuadricula", "aleatoria", "libre_escala", "cadena"};
+    long long minCentros = 1000; // Tamaño de la red más chica (se multiplica por 10 hasta maxCentros)
+    long long maxCentros = 1000000; // Tamaño de la red más grande (hasta 10000000)
+    uint64_t semilla = 42; // Semilla de los generadores y de los orígenes y destinos elegidos
+    int hilos = 0; // Hilos para el cálculo desde todos los orígenes (0 = todos los núcleos)
+    int origenes = 5; // Búsquedas desde un origen por red
+    int consultas = 200; // Consultas de ruta entre dos centros por red y modo
+    long long maxTodosOrigenes = 5000; // Redes más grandes omiten el cálculo desde todos los orígenes y las contingencias
+    int delta = 0; // Ancho de cubeta de delta-stepping (0 = automático)
+    long long maxJerarquia = 10000; // Redes más grandes omiten la jerarquía de contracción
+    long long maxMatriz = 4096; // Redes más grandes omiten la matriz de distancias
+};
+
+/**
+ * Lee las opciones de la línea de comandos.
+ *
+ * @return false si alguna opción no se reconoce.
+ */
+bool leerOpciones(int argc, char* argv[], OpcionesBenchmark& opciones) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string nombre = argv[i];
+        std::string valor = argv[i + 1];
+        if (nombre == "--generadores") {
+            opciones.generadores.clear();
+            std::stringstream lista(valor);
+            std::string generador;
+            while (std::getline(lista, generador, ',')) {
+                opciones.generadores.push_back(generador);
+            }
+        } else if (nombre == "--min-centros") {
+            opciones.minCentros = std::atoll(valor.c_str());
+        } else if (nombre == "--max-centros") {
+            opciones.maxCentros = std::atoll(valor.c_str());
+        } else if (nombre == "--semilla") {
+            opciones.semilla = std::strtoull(valor.c_str(), nullptr, 10);
+        } else if (nombre == "--hilos") {
+            opciones.hilos = std::atoi(valor.c_str());
+        } else if (nombre == "--origenes") {
+            opciones.origenes = std::atoi(valor.c_str());
+        } else if (nombre == "--consultas") {
+            opciones.consultas = std::atoi(valor.c_str());
+        } else if (nombre == "--delta") {
+            opciones.delta = std::atoi(valor.c_str());
+        } else if (nombre == "--max-jerarquia") {
+            opciones.maxJerarquia = std::atoll(valor.c_str());
+        } else if (nombre == "--max-matriz") {
+            opciones.maxMatriz = std::atoll(valor.c_str());
+        } else if (nombre == "--max-todos-origenes") {
+            opciones.maxTodosOrigenes = std::atoll(valor.c_str());
+        } else {
+            return false;
+        }
+    }
+    return argc % 2 == 1 && opciones.minCentros >= 1 && opciones.maxCentros <= 10000000;
+}
+
+/**
+ * Obtiene el pico de memoria residente del proceso en kilobytes.
+ */
+long long obtenerRssPicoKb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS contadores;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &contadores, sizeof(contadores))) {
+        return static_cast<long long>(contadores.PeakWorkingSetSize / 1024);
+    }
+    return -1;
+#else
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    #ifdef __APPLE__
+        return uso.ru_maxrss / 1024; // macOS informa bytes
+    #else
+        return uso.ru_maxrss;
+    #endif
+#endif
+}
+
+/**
+ * Imprime una medición como una línea JSON.
+ */
+void imprimirMedicion(const std::string& generador, const RedCSR& red, uint64_t semilla, const std::string& operacion,
+                      long long repeticiones, double segundos, long long centros, long long relajaciones) {
+    std::cout << "{\"generador\":\"" << generador << "\""
+              << ",\"centros\":" << red.inicioAdyacentes.size() - 1
+              << ",\"tuberias\":" << red.destinos.size()
+              << ",\"semilla\":" << semilla
+              << ",\"operacion\":\"" << operacion << "\""
+              << ",\"repeticiones\":" << repeticiones
+              << ",\"segundos\":" << segundos
+              << ",\"segundos_por_repeticion\":" << (repeticiones > 0 ? segundos / repeticiones : 0)
+              << ",\"centros_por_segundo\":" << (segundos > 0 ? centros / segundos : 0)
+              << ",\"relajaciones_por_segundo\":" << (segundos > 0 ? relajaciones / segundos : 0)
+              << ",\"rss_pico_kb\":" << obtenerRssPicoKb()
+              << "}" << std::endl;
+}
+
+/**
+ * Mide Dijkstra completo desde cada origen sobre un espacio reutilizado, con la red copiada a los tipos indicados.
+ * Con tipos más chicos que int la instantánea ocupa menos y entra más de ella en la caché.
+ *
+ * @return false si la red no cabe en esos tipos (no se imprime nada).
+ */
+template <typename Tipos>
+bool medirUnOrigen(const std::string& generador, Rutas& G, const std::vector<int>& origenes, const OpcionesBenchmark& opciones,
+                   const std::string& operacion) {
+    RedCSRCon<Tipos> red;
+    if (!convertirRedCSR(G.getRedCSR(), red)) {
+        return false;
+    }
+    EspacioDijkstraPara<Tipos> espacio(G.getNumeroCentrosAgua(), G.getMinutosMaximo());
+    long long asentados = 0;
+    long long relajaciones = 0;
+    auto inicio = std::chrono::steady_clock::now();
+    for (int origen : origenes) {
+        relajaciones += espacio.ejecutar(red, static_cast<typename Tipos::Centro>(origen));
+        asentados += static_cast<long long>(espacio.getAsentados().size());
+    }
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    imprimirMedicion(generador, G.getRedCSR(), opciones.semilla, operacion, static_cast<long long>(origenes.size()), segundos,
+                     asentados, relajaciones);
+    return true;
+}
+
+/**
+ * Mide las operaciones sobre una red ya generada.
+ */
+void medirRed(const std::string& generador, int numeroCentrosAgua, const OpcionesBenchmark& opciones, PoolHilos& pool) {
+    using reloj = std::chrono::steady_clock;
+    auto segundosDesde = [](reloj::time_point inicio) {
+        return std::chrono::duration<double>(reloj::now() - inicio).count();
+    };
+
+    reiniciarInstrumentacion();
+    auto inicio = reloj::now();
+    RedCSR generada;
+    generarRed(generador, numeroCentrosAgua, opciones.semilla, generada);
+    Rutas G(std::move(generada));
+    const RedCSR& red = G.getRedCSR();
+    imprimirMedicion(generador, red, opciones.semilla, "generacion", 1, segundosDesde(inicio), numeroCentrosAgua, 0);
+
+    std::mt19937_64 generadorConsultas(opciones.semilla ^ static_cast<uint64_t>(numeroCentrosAgua));
+    std::uniform_int_distribution<int> centro(0, numeroCentrosAgua - 1);
+
+    // Dijkstra completo desde un origen, sobre un espacio reutilizado; luego los mismos orígenes con la red en 16 bits
+    // (centros y minutos, o solo minutos si tiene más de 65535 centros)
+    {
+        std::vector<int> origenes(opciones.origenes);
+        for (int& origen : origenes) {
+            origen = centro(generadorConsultas);
+        }
+        medirUnOrigen<TiposRedPredeterminados>(generador, G, origenes, opciones, "un_origen");
+        if (!medirUnOrigen<TiposRedPequenos>(generador, G, origenes, opciones, "un_origen_pequenos")) {
+            medirUnOrigen<TiposRedCompactos>(generador, G, origenes, opciones, "un_origen_compactos");
+        }
+
+        // Los mismos orígenes sobre el archivo binario mapeado: abrirlo solo lee la cabecera
+        const std::string archivoMapeado = "benchmark_rutas_red.bin";
+        if (guardarRedBinaria(red, archivoMapeado)) {
+            RedMapeada redMapeada;
+            inicio = reloj::now();
+            bool abierta = redMapeada.abrir(archivoMapeado);
+            imprimirMedicion(generador, red, opciones.semilla, "apertura_mapeada", 1, segundosDesde(inicio), 0, 0);
+            if (abierta) {
+                EspacioDijkstra espacio(numeroCentrosAgua, G.getMinutosMaximo());
+                long long asentados = 0;
+                long long relajaciones = 0;
+                inicio = reloj::now();
+                for (int origen : origenes) {
+                    relajaciones += espacio.ejecutar(redMapeada.getRed(), origen);
+                    asentados += static_cast<long long>(espacio.getAsentados().size());
+                }
+                imprimirMedicion(generador, red, opciones.semilla, "un_origen_mapeado", static_cast<long long>(origenes.size()),
+                                 segundosDesde(inicio), asentados, relajaciones);
+            }
+        }
+        std::remove(archivoMapeado.c_str());
+    }
+
+    // Consultas desde los hilos del pool sobre versiones fijadas mientras un escritor cambia disponibilidades
+    {
+        RedVersionada versionada(G, pool.getNumeroHilos());
+        versionada.setMostrarMensajes(false);
+        std::vector<EspacioDijkstra> espacios;
+        for (int hilo = 0; hilo < pool.getNumeroHilos(); ++hilo) {
+            espacios.emplace_back(numeroCentrosAgua, G.getMinutosMaximo());
+        }
+        std::vector<int> origenes(opciones.consultas);
+        for (int& origen : origenes) {
+            origen = centro(generadorConsultas);
+        }
+        std::vector<long long> asentadosHilo(pool.getNumeroHilos(), 0);
+        std::vector<long long> relajacionesHilo(pool.getNumeroHilos(), 0);
+        std::atomic<bool> terminar(false);
+        long long ediciones = 0;
+        int numeroTuberias = static_cast<int>(red.destinos.size());
+        std::thread escritor([&] {
+            std::mt19937_64 generadorEdiciones(opciones.semilla);
+            std::uniform_int_distribution<int> elegirTuberia(0, std::max(0, numeroTuberias - 1));
+            while (numeroTuberias > 0 && !terminar.load()) {
+                int tuberia = elegirTuberia(generadorEdiciones);
+                int u = static_cast<int>(std::upper_bound(red.inicioAdyacentes.begin(), red.inicioAdyacentes.end(), tuberia) -
+                                         red.inicioAdyacentes.begin()) - 1;
+                // Deshabilita la tubería y le devuelve su estado: la red medida no se degrada mientras dura la medición
+                versionada.establecerDisponibilidad(u, red.destinos[tuberia], false);
+                versionada.establecerDisponibilidad(u, red.destinos[tuberia], red.disponibles[tuberia] != 0);
+                ediciones += 2;
+            }
+        });
+        inicio = reloj::now();
+        pool.paraCada(opciones.consultas, [&](int hilo, int indice) {
+            LecturaRed lectura(versionada, hilo);
+            relajacionesHilo[hilo] += espacios[hilo].ejecutar(*lectura, origenes[indice]);
+            asentadosHilo[hilo] += static_cast<long long>(espacios[hilo].getAsentados().size());
+        });
+        double segundos = segundosDesde(inicio);
+        terminar = true;
+        escritor.join();
+        long long asentados = 0;
+        long long relajaciones = 0;
+        for (int hilo = 0; hilo < pool.getNumeroHilos(); ++hilo) {
+            asentados += asentadosHilo[hilo];
+            relajaciones += relajacionesHilo[hilo];
+        }
+        imprimirMedicion(generador, red, opciones.semilla, "consultas_concurrentes", opciones.consultas, segundos, asentados, relajaciones);
+        imprimirMedicion(generador, red, opciones.semilla, "ediciones_concurrentes", ediciones, segundos, 0, 0);
+    }
+
+    // Delta-stepping paralelo desde los mismos tipos de origen
+    {
+        long long asentados = 0;
+        double segundos = 0;
+        for (int i = 0; i < opciones.origenes; ++i) {
+            int origen = centro(generadorConsultas);
+            inicio = reloj::now();
+            std::vector<int> minutos = DijkstraDeltaStepping(G, origen, pool, opciones.delta).first;
+            segundos += segundosDesde(inicio);
+            for (int minutosCentro : minutos) {
+                asentados += minutosCentro != INT_MAX;
+            }
+        }
+        imprimirMedicion(generador, red, opciones.semilla, "delta_stepping", opciones.origenes, segundos, asentados, 0);
+    }
+
+    // Consultas de ruta entre dos centros, unidireccionales y bidireccionales sobre los mismos pares
+    {
+        ConsultaRuta consulta(G);
+        G.getRedInversaCSR(); // La red inversa se arma fuera de la medición
+        std::vector<std::pair<int, int>> pares(opciones.consultas);
+        for (auto& par : pares) {
+            par = {centro(generadorConsultas), centro(generadorConsultas)};
+        }
+        for (bool bidireccional : {false, true}) {
+            long long asentados = 0;
+            long long relajaciones = 0;
+            inicio = reloj::now();
+            for (const auto& [origen, destino] : pares) {
+                consulta.ruta(origen, destino, bidireccional);
+                asentados += consulta.getCentrosAsentados();
+                relajaciones += consulta.getRelajaciones();
+            }
+            imprimirMedicion(generador, red, opciones.semilla, bidireccional ? "ruta_bidireccional" : "ruta_unidireccional",
+                             opciones.consultas, segundosDesde(inicio), asentados, relajaciones);
+        }
+
+        // Jerarquía de contracción: preparación y las mismas consultas sobre la jerarquía
+        if (numeroCentrosAgua <= opciones.maxJerarquia) {
+            JerarquiaContraccion jerarquia;
+            inicio = reloj::now();
+            jerarquia.construir(G);
+            imprimirMedicion(generador, red, opciones.semilla, "jerarquia_preparacion", 1, segundosDesde(inicio),
+                             numeroCentrosAgua, 0);
+            ConsultaJerarquica consultaJerarquica(jerarquia, G);
+            long long asentados = 0;
+            inicio = reloj::now();
+            for (const auto& [origen, destino] : pares) {
+                consultaJerarquica.ruta(origen, destino);
+                asentados += consultaJerarquica.getCentrosAsentados();
+            }
+            imprimirMedicion(generador, red, opciones.semilla, "ruta_jerarquia", opciones.consultas, segundosDesde(inicio), asentados, 0);
+        }
+    }
+
+    // Cálculo desde todos los orígenes (opción 6) y búsqueda del origen óptimo
+    if (numeroCentrosAgua <= opciones.maxTodosOrigenes) {
+        inicio = reloj::now();
+        ResultadoTodosOrigenes resultado = calcularTodosOrigenesDijkstra(G, pool);
+        double segundos = segundosDesde(inicio);
+        long long asentados = 0;
+        long long relajaciones = 0;
+        for (const ResumenOrigen& resumen : resultado.resumenes) {
+            asentados += numeroCentrosAgua - resumen.centrosInalcanzables;
+            relajaciones += resumen.relajaciones;
+        }
+        imprimirMedicion(generador, red, opciones.semilla, "todos_origenes", numeroCentrosAgua, segundos, asentados, relajaciones);
+
+        // Lo mismo con la matriz de distancias, para comparar con la elección automática de calcularTodosOrigenes
+        if (numeroCentrosAgua <= opciones.maxMatriz) {
+            inicio = reloj::now();
+            calcularTodosOrigenesMatriz(G, pool);
+            imprimirMedicion(generador, red, opciones.semilla, MatrizDistancias::convieneMatriz(red, opciones.maxMatriz)
+                             ? "todos_origenes_matriz_elegida" : "todos_origenes_matriz", numeroCentrosAgua, segundosDesde(inicio), 0, 0);
+        }
+
+        // Origen óptimo por ramificación y poda, con cada objetivo
+        const std::pair<ObjetivoOrigen, const char*> objetivos[] = {
+            {ObjetivoMinutosTotales, "origen_optimo_minutos"}, {ObjetivoMinutosMaximo, "origen_optimo_maximo"},
+            {ObjetivoAlcanzables, "origen_optimo_alcanzables"}};
+        for (const auto& [objetivo, operacion] : objetivos) {
+            inicio = reloj::now();
+            ResultadoOrigenOptimo optimo = buscarOrigenOptimo(G, pool, objetivo);
+            imprimirMedicion(generador, red, opciones.semilla, operacion, numeroCentrosAgua, segundosDesde(inicio), optimo.centrosAsentados, 0);
+        }
+
+        // Contingencias N-1 desde un origen: reparando el subárbol afectado y recalculando cada escenario desde cero
+        {
+            int origen = centro(generadorConsultas);
+            inicio = reloj::now();
+            ResultadoContingencia contingencia = analizarContingencias(G, pool, {origen});
+            imprimirMedicion(generador, red, opciones.semilla, "contingencia", static_cast<long long>(contingencia.impactos.size()),
+                             segundosDesde(inicio), contingencia.centrosRecalculados, 0);
+            EspacioDijkstra espacio(numeroCentrosAgua, G.getMinutosMaximo());
+            long long asentados = 0;
+            long long relajaciones = 0;
+            inicio = reloj::now();
+            for (int tuberia = 0; tuberia < static_cast<int>(red.destinos.size()); ++tuberia) {
+                if (red.disponibles[tuberia]) {
+                    relajaciones += espacio.ejecutar(RedConFalla(red, tuberia), origen);
+                    asentados += static_cast<long long>(espacio.getAsentados().size());
+                }
+            }
+            imprimirMedicion(generador, red, opciones.semilla, "contingencia_recalculo", static_cast<long long>(contingencia.impactos.size()),
+                             segundosDesde(inicio), asentados, relajaciones);
+        }
+    }
+
+    // Contadores de todas las mediciones de esta red (solo compilando con -DINSTRUMENTAR)
+    if (instrumentacionActiva) {
+        std::cout << "{\"generador\":\"" << generador << "\",\"centros\":" << numeroCentrosAgua
+                  << ",\"semilla\":" << opciones.semilla << ",\"operacion\":\"instrumentacion\",\"datos\":";
+        volcarInstrumentacion(std::cout);
+        std::cout << "}" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    OpcionesBenchmark opciones;
+    if (!leerOpciones(argc, argv, opciones)) {
+        std::cerr << "Opciones invalidas; ver el comentario al inicio de benchmark_rutas.cpp" << std::endl;
+        return 1;
+    }
+
+    PoolHilos pool(opciones.hilos);
+    for (const std::string& generador : opciones.generadores) {
+        RedCSR prueba;
+        if (!generarRed(generador, 1, opciones.semilla, prueba)) {
+            std::cerr << "Generador desconocido: " << generador << std::endl;
+            return 1;
+        }
+        for (long long numeroCentrosAgua = opciones.minCentros; numeroCentrosAgua <= opciones.maxCentros; numeroCentrosAgua *= 10) {
+            medirRed(generador, static_cast<int>(numeroCentrosAgua), opciones, pool);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,215 @@
+#ifndef CACHE_ARBOLES_H
+#define CACHE_ARBOLES_H
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <climits>
+#include <cstddef>
+#include "rutas.h"
+#include "dijkstra.h"
+
+/*Caché de árboles de rutas más cortas (minutos y previos desde un origen) para quien pide una y otra vez los mismos
+  orígenes. Cada árbol se guarda con la versión de la red sobre la que se calculó: la clave es (origen, versión), y
+  como una versión vieja ya no sirve para nada, de cada origen se conserva solo el árbol más reciente.
+
+  Si la red cambió desde que se calculó un árbol, antes de descartarlo se revisan los cambios registrados por Rutas
+  desde su versión (ver Rutas::getRegistroCambios). Un cambio en la tubería u -> v solo afecta al árbol si:
+   - la tubería empeora (se deshabilita o se hace más lenta) y es la tubería del árbol que llega a v, o
+   - la tubería mejora (se habilita, se agrega o se hace más rápida) y con ella v quedaría más cerca del origen.
+  Si ninguno lo afecta, el árbol sigue siendo exacto y se pasa a la versión actual sin recalcularlo. Solo cuando el
+  registro ya olvidó alguno de los cambios el árbol se descarta sin revisar.
+
+  La memoria se limita en bytes; al pasarse del límite se expulsan los árboles usados hace más tiempo. */
+
+/**
+ * Estructura ArbolCacheado
+ *
+ * Árbol de rutas de un origen, como el resultado de Dijkstra, con la versión de la red para la que es exacto.
+ */
+struct ArbolCacheado {
+    int origen; // Centro de agua de origen
+    unsigned long long version; // Versión de la red para la que el árbol es exacto
+    std::vector<int> minutosParaLlegarAcumulados; // Tiempo acumulado mínimo hacia cada centro (INT_MAX sin camino)
+    std::vector<int> centrosAguaPrevio; // Centro previo de cada centro en su ruta, para reconstruirRuta
+};
+
+/**
+ * Estructura EstadisticasCache
+ *
+ * Contadores de uso de la caché desde su creación o el último reinicio.
+ */
+struct EstadisticasCache {
+    long long aciertos = 0; // Consultas respondidas con un árbol de la versión actual
+    long long revalidados = 0; // Aciertos de un árbol de una versión anterior que ningún cambio afectaba
+    long long fallos = 0; // Consultas que tuvieron que ejecutar Dijkstra
+    long long invalidados = 0; // Árboles descartados porque un cambio los afectaba o el registro ya no los cubría
+    long long expulsados = 0; // Árboles descartados para respetar el límite de memoria
+};
+
+/**
+ * Clase CacheArboles
+ *
+ * Caché LRU de árboles de rutas sobre una red. No es segura para usar desde varios hilos a la vez.
+ */
+class CacheArboles {
+    private:
+        Rutas& G; // Red de tuberías de agua
+        size_t limiteBytes; // Memoria máxima de los árboles guardados
+        size_t bytesUsados = 0; // Memoria de los árboles guardados
+        std::list<ArbolCacheado> arboles; // Árboles del usado más recientemente al más antiguo
+        std::unordered_map<int, std::list<ArbolCacheado>::iterator> porOrigen; // Posición de cada origen en la lista
+        EspacioDijkstra espacio; // Buffers de Dijkstra para los fallos (su cola se adapta si la red gana tuberías más lentas)
+        EstadisticasCache estadisticas; // Contadores de uso
+
+        /**
+         * Memoria que ocupa el árbol de una red de n centros.
+         */
+        static size_t bytesArbol(int numeroCentrosAgua) {
+            return 2 * sizeof(int) * static_cast<size_t>(numeroCentrosAgua) + sizeof(ArbolCacheado);
+        }
+
+        /**
+         * Revisa los cambios registrados desde la versión del árbol.
+         *
+         * @return Verdadero si el árbol sigue siendo exacto para la versión actual de la red.
+         */
+        bool sigueVigente(const ArbolCacheado& arbol) const {
+            if (!G.registroCubre(arbol.version)) {
+                return false;
+            }
+            const std::vector<int>& minutos = arbol.minutosParaLlegarAcumulados;
+            const std::deque<CambioTuberia>& cambios = G.getRegistroCambios();
+            // Los cambios están ordenados por versión: se recorren desde el final hasta llegar a los ya vistos
+            for (auto it = cambios.rbegin(); it != cambios.rend() && it->version > arbol.version; ++it) {
+                const CambioTuberia& cambio = *it;
+                bool empeora = cambio.disponibleAntes && (!cambio.disponible || cambio.minutos > cambio.minutosAntes);
+                bool mejora = cambio.disponible && (!cambio.disponibleAntes || cambio.minutos < cambio.minutosAntes);
+                if (empeora && arbol.centrosAguaPrevio[cambio.v] == cambio.u) {
+                    return false;
+                }
+                if (mejora && minutos[cambio.u] != INT_MAX &&
+                    static_cast<long long>(minutos[cambio.u]) + cambio.minutos < minutos[cambio.v]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * Quita un árbol de la caché.
+         */
+        void quitar(std::list<ArbolCacheado>::iterator it) {
+            bytesUsados -= bytesArbol(static_cast<int>(it->minutosParaLlegarAcumulados.size()));
+            porOrigen.erase(it->origen);
+            arboles.erase(it);
+        }
+
+        /**
+         * Expulsa los árboles usados hace más tiempo hasta respetar el límite, sin tocar el más reciente.
+         */
+        void respetarLimite() {
+            while (bytesUsados > limiteBytes && arboles.size() > 1) {
+                quitar(std::prev(arboles.end()));
+                estadisticas.expulsados++;
+            }
+        }
+
+    public:
+        /**
+         * Constructor de la clase CacheArboles.
+         *
+         * @param G Red de tuberías de agua; sus cambios deben hacerse a través de Rutas para quedar registrados.
+         * @param limiteBytes Memoria máxima de los árboles guardados (64 MB por defecto). Siempre se guarda al menos
+         *                    el último árbol pedido.
+         */
+        CacheArboles(Rutas& G, size_t limiteBytes = 64u << 20)
+            : G(G), limiteBytes(limiteBytes), espacio(G.getNumeroCentrosAgua(), G.getMinutosMaximo()) {}
+
+        /**
+         * Obtiene el árbol de rutas de un origen para la versión actual de la red: lo toma de la caché si sigue
+         * siendo exacto y si no ejecuta Dijkstra y lo guarda.
+         *
+         * @param origen Índice del centro de agua de origen.
+         * @return Referencia al árbol, válida hasta la siguiente llamada que modifique la caché.
+         */
+        const ArbolCacheado& obtener(int origen) {
+            unsigned long long versionActual = G.getVersion();
+            auto encontrado = porOrigen.find(origen);
+            if (encontrado != porOrigen.end()) {
+                auto it = encontrado->second;
+                if (it->version == versionActual) {
+                    estadisticas.aciertos++;
+                } else if (sigueVigente(*it)) {
+                    it->version = versionActual;
+                    estadisticas.revalidados++;
+                } else {
+                    quitar(it);
+                    estadisticas.invalidados++;
+                    it = arboles.end();
+                }
+                if (it != arboles.end()) {
+                    arboles.splice(arboles.begin(), arboles, it); // Pasa a ser el usado más recientemente
+                    return arboles.front();
+                }
+            }
+
+            estadisticas.fallos++;
+            espacio.ejecutar(G.getRedCSR(), origen);
+            arboles.push_front(ArbolCacheado{origen, versionActual, {}, {}});
+            espacio.copiarResultado(arboles.front().minutosParaLlegarAcumulados, arboles.front().centrosAguaPrevio);
+            porOrigen[origen] = arboles.begin();
+            bytesUsados += bytesArbol(G.getNumeroCentrosAgua());
+            respetarLimite();
+            return arboles.front();
+        }
+
+        /**
+         * Cambia el límite de memoria, expulsando los árboles que sobren.
+         *
+         * @param bytes Nueva memoria máxima de los árboles guardados.
+         */
+        void setLimiteBytes(size_t bytes) {
+            limiteBytes = bytes;
+            respetarLimite();
+        }
+
+        /**
+         * Descarta todos los árboles guardados (las estadísticas se conservan).
+         */
+        void vaciar() {
+            arboles.clear();
+            porOrigen.clear();
+            bytesUsados = 0;
+        }
+
+        /**
+         * Obtiene los contadores de uso de la caché.
+         */
+        const EstadisticasCache& getEstadisticas() const {
+            return estadisticas;
+        }
+
+        /**
+         * Pone a cero los contadores de uso de la caché.
+         */
+        void reiniciarEstadisticas() {
+            estadisticas = EstadisticasCache();
+        }
+
+        /**
+         * Obtiene la cantidad de árboles guardados.
+         */
+        int getNumeroArboles() const {
+            return static_cast<int>(arboles.size());
+        }
+
+        /**
+         * Obtiene la memoria que ocupan los árboles guardados.
+         */
+        size_t getBytesUsados() const {
+            return bytesUsados;
+        }
+};
+
+#endif // CACHE_ARBOLES_H
@@ -0,0 +1,720 @@
+#ifndef COLA_PRIORIDAD_H
+#define COLA_PRIORIDAD_H
+
+#include <vector>
+#include <set>
+#include <iterator>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+#include <limits>
+#include "instrumentacion.h"
+
+/**
+ * Clase ColaPrioridad
+ *
+ * Esta clase implementa una cola de prioridad utilizando un multiset de la STL de C++. 
+ * La cola de prioridad es esencial para el algoritmo de Dijkstra, ya que permite extraer 
+ * el elemento con la menor prioridad (o costo, en este caso en el menor tiempo de llegada) de manera eficiente.
+ */
+class ColaPrioridad {
+    private:
+        // Multiset para almacenar los elementos junto con sus prioridades
+        std::multiset<std::pair<int, int>> elementos;
+
+    public:
+        // Constructor de la clase ColaPrioridad
+        ColaPrioridad() {}
+
+        /**
+         * Inserta un elemento con una prioridad dada en la cola de prioridad.
+         * 
+         * @param elemento El elemento a insertar.
+         * @param prioridad La prioridad del elemento.
+         */
+        void insertar(int elemento, int prioridad) {
+            elementos.insert({prioridad, elemento});
+        }
+
+        /**
+         * Extrae el elemento con la menor prioridad de la cola de prioridad.
+         * 
+         * @return El elemento con la menor prioridad.
+         */
+        int extraerMinimo() {
+            int minimo = elementos.begin()->second; // Acceder al segundo elemento del par del primer elemento
+            elementos.erase(elementos.begin()); // Eliminar el primer elemento
+            return minimo;
+        }
+
+        /**
+         * Inserta un nuevo elemento o decrementa la prioridad de un elemento existente.
+         * 
+         * @param elemento El elemento a insertar o cuyo prioridad se debe decrementar.
+         * @param nuevaPrioridad La nueva prioridad del elemento.
+         */
+        void insertarODecrementar(int elemento, int nuevaPrioridad) {
+            for (auto it = elementos.begin(); it != elementos.end(); ++it) {
+                if (it->second == elemento) {
+                    elementos.erase(it);
+                    break;
+                }
+            }
+            elementos.insert({nuevaPrioridad, elemento});
+        }
+
+        /**
+         * Encuentra el índice de un elemento en la cola de prioridad.
+         * 
+         * @param elemento El elemento a encontrar.
+         * @return El índice del elemento, o -1 si no se encuentra.
+         */
+        int encontrarElemento(int elemento) {
+            for (auto it = elementos.begin(); it != elementos.end(); ++it) {
+                if (it->second == elemento) {
+                    return std::distance(elementos.begin(), it); // Índice
+                }
+            }
+            return -1;
+        }
+
+        /**
+         * Obtiene los elementos de la cola de prioridad.
+         * 
+         * @return El multiset de elementos y sus prioridades.
+         */
+        const std::multiset<std::pair<int, int>>& getElementos() {
+            return elementos;
+        }
+
+        /**
+         * Vacía la cola para reutilizarla en otra búsqueda.
+         */
+        void vaciar() {
+            elementos.clear();
+        }
+
+        /**
+         * Verifica si la cola de prioridad está vacía.
+         * 
+         * @return Verdadero si la cola está vacía, falso en caso contrario.
+         */
+        bool isEmpty() {
+            return elementos.empty();
+        }
+};
+
+/**
+ * Clase ColaPrioridadIndexada
+ *
+ * Cola de prioridad implementada como un montículo d-ario indexado. Además del arreglo del montículo, mantiene un
+ * mapa de posiciones (elemento -> índice dentro del montículo) que permite comprobar la pertenencia en O(1) y
+ * decrementar la prioridad de un elemento en O(log n) sin recorrer la cola. Los elementos deben ser enteros en el
+ * rango [0, capacidad), como los índices de los centros de agua.
+ *
+ * @tparam D Número de hijos de cada nodo del montículo (4 por defecto, que aprovecha mejor la caché que el binario).
+ * @tparam Prioridad Tipo de las prioridades (los minutos acumulados de la red, ver TiposRed::Distancia).
+ */
+template <int D = 4, typename Prioridad = int>
+class ColaPrioridadIndexada {
+    static_assert(D >= 2, "El montículo necesita al menos dos hijos por nodo");
+
+    private:
+        std::vector<std::pair<Prioridad, int>> monticulo; // Pares (prioridad, elemento) ordenados como montículo d-ario
+        std::vector<int> posiciones; // Posición de cada elemento en el montículo, o -1 si no está en la cola
+
+        /**
+         * Coloca un par en la posición indicada del montículo y actualiza el mapa de posiciones.
+         */
+        void colocar(int indice, const std::pair<Prioridad, int>& par) {
+            monticulo[indice] = par;
+            posiciones[par.second] = indice;
+        }
+
+        /**
+         * Sube un elemento hacia la raíz mientras su prioridad sea menor que la de su padre.
+         */
+        void subir(int indice) {
+            std::pair<Prioridad, int> par = monticulo[indice];
+            while (indice > 0) {
+                int padre = (indice - 1) / D;
+                if (!(par < monticulo[padre])) {
+                    break;
+                }
+                colocar(indice, monticulo[padre]);
+                indice = padre;
+            }
+            colocar(indice, par);
+        }
+
+        /**
+         * Baja un elemento hacia las hojas mientras alguno de sus hijos tenga menor prioridad.
+         */
+        void bajar(int indice) {
+            std::pair<Prioridad, int> par = monticulo[indice];
+            int tamano = static_cast<int>(monticulo.size());
+            while (true) {
+                int primerHijo = indice * D + 1;
+                if (primerHijo >= tamano) {
+                    break;
+                }
+                int ultimoHijo = std::min(primerHijo + D, tamano);
+                int menor = primerHijo;
+                for (int hijo = primerHijo + 1; hijo < ultimoHijo; ++hijo) {
+                    if (monticulo[hijo] < monticulo[menor]) {
+                        menor = hijo;
+                    }
+                }
+                if (!(monticulo[menor] < par)) {
+                    break;
+                }
+                colocar(indice, monticulo[menor]);
+                indice = menor;
+            }
+            colocar(indice, par);
+        }
+
+    public:
+        /**
+         * Constructor de la clase ColaPrioridadIndexada.
+         *
+         * @param capacidad Cantidad de elementos distintos que puede contener la cola (número de centros de agua).
+         */
+        ColaPrioridadIndexada(int capacidad) : posiciones(capacidad, -1) {
+            monticulo.reserve(capacidad);
+        }
+
+        /**
+         * Inserta un elemento con una prioridad dada en la cola de prioridad.
+         * 
+         * @param elemento El elemento a insertar (no debe estar ya en la cola).
+         * @param prioridad La prioridad del elemento.
+         */
+        void insertar(int elemento, Prioridad prioridad) {
+            INSTRUMENTAR_CONTAR(EventoColaInsercion);
+            monticulo.push_back({prioridad, elemento});
+            subir(static_cast<int>(monticulo.size()) - 1);
+        }
+
+        /**
+         * Extrae el elemento con la menor prioridad de la cola de prioridad.
+         * 
+         * @return El elemento con la menor prioridad.
+         */
+        int extraerMinimo() {
+            INSTRUMENTAR_CONTAR(EventoColaExtraccion);
+            int minimo = monticulo.front().second;
+            posiciones[minimo] = -1;
+            std::pair<Prioridad, int> ultimo = monticulo.back();
+            monticulo.pop_back();
+            if (!monticulo.empty()) {
+                colocar(0, ultimo);
+                bajar(0);
+            }
+            return minimo;
+        }
+
+        /**
+         * Inserta un nuevo elemento o cambia la prioridad de un elemento existente, reubicándolo en O(log n).
+         * 
+         * @param elemento El elemento a insertar o cuya prioridad se debe decrementar.
+         * @param nuevaPrioridad La nueva prioridad del elemento.
+         */
+        void insertarODecrementar(int elemento, Prioridad nuevaPrioridad) {
+            int indice = posiciones[elemento];
+            if (indice == -1) {
+                insertar(elemento, nuevaPrioridad);
+                return;
+            }
+            INSTRUMENTAR_CONTAR(EventoColaCambioPrioridad);
+            Prioridad prioridadAnterior = monticulo[indice].first;
+            monticulo[indice].first = nuevaPrioridad;
+            if (nuevaPrioridad < prioridadAnterior) {
+                subir(indice);
+            } else {
+                bajar(indice);
+            }
+        }
+
+        /**
+         * Encuentra el índice de un elemento dentro del montículo.
+         * 
+         * @param elemento El elemento a encontrar.
+         * @return El índice del elemento en el montículo, o -1 si no se encuentra.
+         */
+        int encontrarElemento(int elemento) const {
+            return posiciones[elemento];
+        }
+
+        /**
+         * Obtiene la prioridad del elemento mínimo sin extraerlo. La cola no debe estar vacía.
+         *
+         * @return La menor prioridad de la cola.
+         */
+        Prioridad prioridadMinima() const {
+            return monticulo.front().first;
+        }
+
+        /**
+         * Vacía la cola en O(tamaño) para reutilizarla después de una búsqueda que terminó antes de tiempo.
+         */
+        void vaciar() {
+            for (const std::pair<Prioridad, int>& par : monticulo) {
+                posiciones[par.second] = -1;
+            }
+            monticulo.clear();
+        }
+
+        /**
+         * Verifica en O(1) si un elemento está en la cola de prioridad.
+         *
+         * @param elemento El elemento a buscar.
+         * @return Verdadero si el elemento está en la cola.
+         */
+        bool contiene(int elemento) const {
+            return posiciones[elemento] != -1;
+        }
+
+        /**
+         * Verifica si la cola de prioridad está vacía.
+         * 
+         * @return Verdadero si la cola está vacía, falso en caso contrario.
+         */
+        bool isEmpty() const {
+            return monticulo.empty();
+        }
+};
+
+/*Colas monótonas para Dijkstra. Los minutos de las tuberías son enteros pequeños y no negativos, y Dijkstra nunca
+  inserta una prioridad menor que la del último elemento extraído; con esas dos condiciones las cubetas reemplazan a
+  las comparaciones del montículo. Ninguna de estas colas admite prioridades menores que la última extraída desde que
+  se vació. Las prioridades son del tipo de los minutos acumulados de la red (int por defecto); el mayor valor del tipo
+  queda reservado, como en TiposRed::sinCamino. */
+
+/**
+ * Clase ColaCubetasDial
+ *
+ * Cola de Dial: una cubeta por valor de prioridad, en un arreglo circular con más cubetas que los minutos de la tubería
+ * más lenta. Mientras se cumpla eso, los elementos en la cola caben en una sola vuelta del arreglo y cada cubeta tiene
+ * una única prioridad. Cada cubeta es una lista doblemente enlazada guardada en arreglos indexados por elemento, así
+ * que insertar, decrementar y quitar cuestan O(1); extraer avanza hasta la siguiente cubeta no vacía.
+ *
+ * @tparam Prioridad Tipo entero de las prioridades.
+ */
+template <typename Prioridad = int>
+class ColaCubetasDial {
+    private:
+        static constexpr Prioridad fueraDeCola = std::numeric_limits<Prioridad>::max(); // Prioridad de un elemento que no está en la cola
+
+        Prioridad mascara; // Número de cubetas - 1 (el número de cubetas es potencia de dos)
+        Prioridad actual = 0; // Prioridad de la cubeta desde la que se busca el mínimo
+        int tamano = 0; // Elementos en la cola
+        std::vector<int> primeroCubeta; // Primer elemento de cada cubeta, o -1 si está vacía
+        std::vector<int> siguiente; // Siguiente elemento en la cubeta de cada elemento
+        std::vector<int> anterior; // Elemento anterior en la cubeta, o -1 si es el primero
+        std::vector<Prioridad> prioridades; // Prioridad de cada elemento, o fueraDeCola si no está en la cola
+
+        /**
+         * Cubeta de una prioridad.
+         */
+        size_t cubetaPara(Prioridad prioridad) const {
+            return static_cast<size_t>(prioridad & mascara);
+        }
+
+        /**
+         * Pone un elemento al principio de la cubeta de su prioridad.
+         */
+        void enlazar(int elemento, Prioridad prioridad) {
+            size_t cubeta = cubetaPara(prioridad);
+            prioridades[elemento] = prioridad;
+            anterior[elemento] = -1;
+            siguiente[elemento] = primeroCubeta[cubeta];
+            if (siguiente[elemento] != -1) {
+                anterior[siguiente[elemento]] = elemento;
+            }
+            primeroCubeta[cubeta] = elemento;
+        }
+
+        /**
+         * Saca un elemento de su cubeta sin cambiar su prioridad.
+         */
+        void desenlazar(int elemento) {
+            if (anterior[elemento] == -1) {
+                primeroCubeta[cubetaPara(prioridades[elemento])] = siguiente[elemento];
+            } else {
+                siguiente[anterior[elemento]] = siguiente[elemento];
+            }
+            if (siguiente[elemento] != -1) {
+                anterior[siguiente[elemento]] = anterior[elemento];
+            }
+        }
+
+    public:
+        /**
+         * Constructor de la clase ColaCubetasDial.
+         *
+         * @param capacidad Cantidad de elementos distintos que puede contener la cola (número de centros de agua).
+         * @param minutosMaximo Minutos de la tubería más lenta; la cola tiene la primera potencia de dos mayor de cubetas.
+         */
+        ColaCubetasDial(int capacidad, long long minutosMaximo)
+            : siguiente(capacidad), anterior(capacidad), prioridades(capacidad, fueraDeCola) {
+            size_t numeroCubetas = 1;
+            while (static_cast<long long>(numeroCubetas) <= minutosMaximo) {
+                numeroCubetas *= 2;
+            }
+            mascara = static_cast<Prioridad>(numeroCubetas - 1);
+            primeroCubeta.assign(numeroCubetas, -1);
+        }
+
+        /**
+         * Indica si una prioridad (no menor que la última extraída) cabe en la vuelta actual del arreglo de cubetas.
+         */
+        bool admite(Prioridad prioridad) const {
+            return prioridad - actual <= mascara;
+        }
+
+        /**
+         * Inserta un elemento que no está en la cola; su prioridad debe cumplir admite.
+         */
+        void insertar(int elemento, Prioridad prioridad) {
+            INSTRUMENTAR_CONTAR(EventoColaInsercion);
+            enlazar(elemento, prioridad);
+            tamano++;
+        }
+
+        /**
+         * Extrae el elemento con la menor prioridad. La cola no debe estar vacía.
+         */
+        int extraerMinimo() {
+            INSTRUMENTAR_CONTAR(EventoColaExtraccion);
+            while (primeroCubeta[cubetaPara(actual)] == -1) {
+                actual++;
+            }
+            int minimo = primeroCubeta[cubetaPara(actual)];
+            desenlazar(minimo);
+            prioridades[minimo] = fueraDeCola;
+            tamano--;
+            return minimo;
+        }
+
+        /**
+         * Inserta un nuevo elemento o lo mueve a la cubeta de su nueva prioridad en O(1).
+         */
+        void insertarODecrementar(int elemento, Prioridad nuevaPrioridad) {
+            if (prioridades[elemento] == fueraDeCola) {
+                insertar(elemento, nuevaPrioridad);
+                return;
+            }
+            INSTRUMENTAR_CONTAR(EventoColaCambioPrioridad);
+            desenlazar(elemento);
+            enlazar(elemento, nuevaPrioridad);
+        }
+
+        /**
+         * Recorre los elementos de la cola con su prioridad, sin quitarlos.
+         *
+         * @param funcion Función (elemento, prioridad).
+         */
+        template <typename Funcion>
+        void paraCadaElemento(Funcion&& funcion) const {
+            int pendientes = tamano;
+            for (Prioridad prioridad = actual; pendientes > 0; ++prioridad) {
+                for (int elemento = primeroCubeta[cubetaPara(prioridad)]; elemento != -1; elemento = siguiente[elemento]) {
+                    funcion(elemento, prioridades[elemento]);
+                    pendientes--;
+                }
+            }
+        }
+
+        /**
+         * Vacía la cola en O(tamaño + cubetas recorridas) para reutilizarla en otra búsqueda.
+         */
+        void vaciar() {
+            for (Prioridad prioridad = actual; tamano > 0; ++prioridad) {
+                size_t cubeta = cubetaPara(prioridad);
+                for (int elemento = primeroCubeta[cubeta]; elemento != -1; elemento = siguiente[elemento]) {
+                    prioridades[elemento] = fueraDeCola;
+                    tamano--;
+                }
+                primeroCubeta[cubeta] = -1;
+            }
+            actual = 0;
+        }
+
+        /**
+         * Verifica en O(1) si un elemento está en la cola de prioridad.
+         */
+        bool contiene(int elemento) const {
+            return prioridades[elemento] != fueraDeCola;
+        }
+
+        /**
+         * Verifica si la cola de prioridad está vacía.
+         */
+        bool isEmpty() const {
+            return tamano == 0;
+        }
+};
+
+/**
+ * Clase ColaRadix
+ *
+ * Montículo radix: la cubeta i guarda los elementos cuya prioridad difiere de la última extraída por primera vez en el
+ * bit i - 1 (la cubeta 0, los que la igualan). Cuando la cubeta 0 se vacía, la primera cubeta no vacía se reparte en
+ * las anteriores tomando su mínimo como nueva referencia, y cada elemento baja de cubeta a lo sumo una vez por bit. No
+ * depende de los minutos de las tuberías, así que sirve para cualquier red.
+ *
+ * @tparam Prioridad Tipo entero de las prioridades (no negativas).
+ */
+template <typename Prioridad = int>
+class ColaRadix {
+    private:
+        static const int numeroCubetas = std::numeric_limits<Prioridad>::digits + 1; // Una cubeta por bit de una prioridad no negativa, más la cubeta 0
+        Prioridad ultimo = 0; // Última prioridad extraída (referencia de las cubetas)
+        int tamano = 0; // Elementos en la cola
+        std::vector<std::pair<Prioridad, int>> cubetas[numeroCubetas]; // Pares (prioridad, elemento) de cada cubeta
+        std::vector<int> cubetaDe; // Cubeta de cada elemento, o -1 si no está en la cola
+        std::vector<int> posicionEn; // Posición de cada elemento dentro de su cubeta
+
+        /**
+         * Cubeta de una prioridad respecto de la última extraída: la posición de su primer bit distinto, más uno.
+         */
+        int cubetaPara(Prioridad prioridad) const {
+            unsigned long long diferencia = static_cast<unsigned long long>(prioridad ^ ultimo);
+            if (diferencia == 0) {
+                return 0;
+            }
+#if defined(__GNUC__) || defined(__clang__)
+            return 64 - __builtin_clzll(diferencia);
+#else
+            int cubeta = 0;
+            while (diferencia != 0) {
+                diferencia >>= 1;
+                cubeta++;
+            }
+            return cubeta;
+#endif
+        }
+
+        /**
+         * Agrega un elemento al final de una cubeta.
+         */
+        void agregar(int elemento, Prioridad prioridad, int cubeta) {
+            cubetaDe[elemento] = cubeta;
+            posicionEn[elemento] = static_cast<int>(cubetas[cubeta].size());
+            cubetas[cubeta].push_back({prioridad, elemento});
+        }
+
+        /**
+         * Quita un elemento de su cubeta poniendo en su lugar el último de la misma cubeta.
+         */
+        void quitar(int elemento) {
+            std::vector<std::pair<Prioridad, int>>& cubeta = cubetas[cubetaDe[elemento]];
+            int posicion = posicionEn[elemento];
+            cubeta[posicion] = cubeta.back();
+            posicionEn[cubeta[posicion].second] = posicion;
+            cubeta.pop_back();
+            cubetaDe[elemento] = -1;
+        }
+
+    public:
+        /**
+         * Constructor de la clase ColaRadix.
+         *
+         * @param capacidad Cantidad de elementos distintos que puede contener la cola (número de centros de agua).
+         */
+        ColaRadix(int capacidad) : cubetaDe(capacidad, -1), posicionEn(capacidad) {}
+
+        /**
+         * Inserta un elemento que no está en la cola, con prioridad no negativa y no menor que la última extraída.
+         */
+        void insertar(int elemento, Prioridad prioridad) {
+            INSTRUMENTAR_CONTAR(EventoColaInsercion);
+            agregar(elemento, prioridad, cubetaPara(prioridad));
+            tamano++;
+        }
+
+        /**
+         * Extrae el elemento con la menor prioridad. La cola no debe estar vacía.
+         */
+        int extraerMinimo() {
+            INSTRUMENTAR_CONTAR(EventoColaExtraccion);
+            if (cubetas[0].empty()) {
+                int cubeta = 1;
+                while (cubetas[cubeta].empty()) {
+                    cubeta++;
+                }
+                std::vector<std::pair<Prioridad, int>> repartir;
+                repartir.swap(cubetas[cubeta]);
+                ultimo = std::min_element(repartir.begin(), repartir.end())->first;
+                for (const std::pair<Prioridad, int>& par : repartir) {
+                    agregar(par.second, par.first, cubetaPara(par.first));
+                }
+                repartir.clear();
+                cubetas[cubeta].swap(repartir); // Conserva la memoria de la cubeta repartida
+            }
+            int minimo = cubetas[0].back().second;
+            cubetas[0].pop_back();
+            cubetaDe[minimo] = -1;
+            tamano--;
+            return minimo;
+        }
+
+        /**
+         * Inserta un nuevo elemento o lo mueve a la cubeta de su nueva prioridad.
+         */
+        void insertarODecrementar(int elemento, Prioridad nuevaPrioridad) {
+            if (cubetaDe[elemento] == -1) {
+                insertar(elemento, nuevaPrioridad);
+                return;
+            }
+            INSTRUMENTAR_CONTAR(EventoColaCambioPrioridad);
+            quitar(elemento);
+            agregar(elemento, nuevaPrioridad, cubetaPara(nuevaPrioridad));
+        }
+
+        /**
+         * Vacía la cola en O(tamaño) y vuelve a admitir cualquier prioridad no negativa.
+         */
+        void vaciar() {
+            for (std::vector<std::pair<Prioridad, int>>& cubeta : cubetas) {
+                for (const std::pair<Prioridad, int>& par : cubeta) {
+                    cubetaDe[par.second] = -1;
+                }
+                cubeta.clear();
+            }
+            ultimo = 0;
+            tamano = 0;
+        }
+
+        /**
+         * Verifica en O(1) si un elemento está en la cola de prioridad.
+         */
+        bool contiene(int elemento) const {
+            return cubetaDe[elemento] != -1;
+        }
+
+        /**
+         * Verifica si la cola de prioridad está vacía.
+         */
+        bool isEmpty() const {
+            return tamano == 0;
+        }
+};
+
+const int limiteMinutosDial = 1 << 20; // Con tuberías más lentas ColaMinutos usa siempre el montículo radix
+const int cubetasDialPorElemento = 16; // Cubetas de Dial por elemento a partir de las que conviene el montículo radix
+
+/**
+ * Clase ColaMinutos
+ *
+ * Cola monótona que elige su implementación según los minutos de la tubería más lenta: la cola de Dial si las cubetas
+ * son pocas comparadas con los elementos (recorrer las vacías cuesta poco) y el montículo radix si no. En las
+ * mediciones de benchmark_cola_prioridad.cpp Dial es la más rápida hasta con tuberías de 1000 minutos y pierde contra
+ * radix cuando hay muchas más cubetas que centros. Si con la cola de Dial llega una prioridad que no cabe en sus
+ * cubetas (por ejemplo porque la red ganó una tubería más lenta después de crear la cola), los elementos pasan al
+ * montículo radix y la cola sigue con él, así que minutosMaximo solo afecta la velocidad.
+ *
+ * @tparam Prioridad Tipo entero de las prioridades (los minutos acumulados de la red).
+ */
+template <typename Prioridad = int>
+class ColaMinutos {
+    private:
+        int capacidad; // Cantidad de elementos distintos que puede contener la cola
+        bool usaDial; // Indica si la cola de Dial está en uso
+        ColaCubetasDial<Prioridad> dial; // Cola de Dial (sin memoria si no se usa)
+        ColaRadix<Prioridad> radix; // Montículo radix (sin memoria si no se usa)
+
+        /**
+         * Pasa los elementos de la cola de Dial al montículo radix, que los admite a todos.
+         */
+        void pasarARadix() {
+            radix = ColaRadix<Prioridad>(capacidad);
+            dial.paraCadaElemento([this](int elemento, Prioridad prioridad) {
+                radix.insertar(elemento, prioridad);
+            });
+            dial = ColaCubetasDial<Prioridad>(0, 0);
+            usaDial = false;
+        }
+
+    public:
+        /**
+         * Constructor de la clase ColaMinutos.
+         *
+         * @param capacidad Cantidad de elementos distintos que puede contener la cola (número de centros de agua).
+         * @param minutosMaximo Minutos de la tubería más lenta de la red (ver Rutas::getMinutosMaximo).
+         */
+        ColaMinutos(int capacidad, long long minutosMaximo)
+            : capacidad(capacidad),
+              usaDial(minutosMaximo >= 0 && minutosMaximo <= limiteMinutosDial && minutosMaximo / cubetasDialPorElemento <= capacidad),
+              dial(usaDial ? capacidad : 0, usaDial ? minutosMaximo : 0), radix(usaDial ? 0 : capacidad) {}
+
+        /**
+         * Indica si la cola usa las cubetas de Dial (si no, el montículo radix).
+         */
+        bool usaCubetasDial() const {
+            return usaDial;
+        }
+
+        void insertar(int elemento, Prioridad prioridad) {
+            if (usaDial) {
+                if (dial.admite(prioridad)) {
+                    dial.insertar(elemento, prioridad);
+                    return;
+                }
+                pasarARadix();
+            }
+            radix.insertar(elemento, prioridad);
+        }
+
+        int extraerMinimo() {
+            return usaDial ? dial.extraerMinimo() : radix.extraerMinimo();
+        }
+
+        void insertarODecrementar(int elemento, Prioridad nuevaPrioridad) {
+            if (usaDial) {
+                if (dial.admite(nuevaPrioridad)) {
+                    dial.insertarODecrementar(elemento, nuevaPrioridad);
+                    return;
+                }
+                pasarARadix();
+            }
+            radix.insertarODecrementar(elemento, nuevaPrioridad);
+        }
+
+        void vaciar() {
+            if (usaDial) {
+                dial.vaciar();
+            } else {
+                radix.vaciar();
+            }
+        }
+
+        bool contiene(int elemento) const {
+            return usaDial ? dial.contiene(elemento) : radix.contiene(elemento);
+        }
+
+        bool isEmpty() const {
+            return usaDial ? dial.isEmpty() : radix.isEmpty();
+        }
+};
+
+/**
+ * Construye una cola vacía del tipo indicado: las colas de minutos reciben la capacidad y los minutos de la tubería
+ * más lenta, las indexadas solo la capacidad y ColaPrioridad nada.
+ *
+ * @param capacidad Cantidad de elementos distintos (número de centros de agua).
+ * @param minutosMaximo Minutos de la tubería más lenta de la red, o -1 si no se conocen.
+ */
+template <typename Cola>
+Cola crearCola(int capacidad, long long minutosMaximo) {
+    if constexpr (std::is_constructible<Cola, int, long long>::value) {
+        return Cola(capacidad, minutosMaximo);
+    } else if constexpr (std::is_constructible<Cola, int>::value) {
+        return Cola(capacidad);
+    } else {
+        return Cola();
+    }
+}
+
+#endif // COLA_PRIORIDAD_H
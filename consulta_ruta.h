@@ -0,0 +1,254 @@
+#ifndef CONSULTA_RUTA_H
+#define CONSULTA_RUTA_H
+
+#include <vector>
+#include <climits>
+#include <algorithm>
+#include "rutas.h"
+#include "cola_prioridad.h"
+#include "instrumentacion.h"
+
+/**
+ * Estructura RutaConsultada
+ *
+ * Resultado de una consulta de ruta entre dos centros de agua.
+ */
+struct RutaConsultada {
+    int minutos = INT_MAX; // Minutos de la ruta más corta, INT_MAX si no hay camino
+    std::vector<int> centros; // Centros de agua desde el origen hasta el destino (vacío si no hay camino)
+};
+
+/**
+ * Clase ConsultaRuta
+ *
+ * Responde consultas de ruta más corta entre un origen y un destino sin explorar toda la red:
+ *  - En modo unidireccional, Dijkstra se detiene en cuanto el destino sale de la cola.
+ *  - En modo bidireccional, una búsqueda avanza desde el origen sobre la red y otra retrocede desde el destino
+ *    sobre la red inversa; se detienen cuando la suma de sus mínimos ya no puede mejorar el mejor encuentro.
+ *
+ * Los buffers se reservan una sola vez y se marcan con un número de consulta, así cada consulta solo paga por los
+ * centros que toca y no por el tamaño de la red.
+ */
+class ConsultaRuta {
+    private:
+        Rutas& G; // Red de tuberías de agua
+        unsigned int consultaActual = 0; // Número de la consulta en curso
+        std::vector<unsigned int> marcaAdelante; // Consulta en la que se tocó cada centro en la búsqueda hacia adelante
+        std::vector<unsigned int> marcaAtras; // Consulta en la que se tocó cada centro en la búsqueda hacia atrás
+        std::vector<int> minutosAdelante; // Minutos desde el origen
+        std::vector<int> minutosAtras; // Minutos hasta el destino
+        std::vector<int> previoAdelante; // Centro previo en la ruta desde el origen
+        std::vector<int> siguienteAtras; // Centro siguiente en la ruta hacia el destino
+        ColaPrioridadIndexada<> colaAdelante; // Cola de la búsqueda hacia adelante
+        ColaPrioridadIndexada<> colaAtras; // Cola de la búsqueda hacia atrás
+        long long centrosAsentados = 0; // Centros extraídos de las colas en la última consulta
+        long long relajaciones = 0; // Tuberías relajadas en la última consulta
+
+        /**
+         * Comienza una nueva consulta; solo cuando el contador da la vuelta se limpian las marcas completas.
+         */
+        void nuevaConsulta() {
+            if (++consultaActual == 0) {
+                std::fill(marcaAdelante.begin(), marcaAdelante.end(), 0);
+                std::fill(marcaAtras.begin(), marcaAtras.end(), 0);
+                consultaActual = 1;
+            }
+            colaAdelante.vaciar();
+            colaAtras.vaciar();
+            centrosAsentados = 0;
+            relajaciones = 0;
+        }
+
+        // Lectura y escritura de los buffers: un centro no tocado en la consulta actual vale INT_MAX
+        int leerAdelante(int centro) const {
+            return marcaAdelante[centro] == consultaActual ? minutosAdelante[centro] : INT_MAX;
+        }
+
+        int leerAtras(int centro) const {
+            return marcaAtras[centro] == consultaActual ? minutosAtras[centro] : INT_MAX;
+        }
+
+        void escribirAdelante(int centro, int minutos, int previo) {
+            marcaAdelante[centro] = consultaActual;
+            minutosAdelante[centro] = minutos;
+            previoAdelante[centro] = previo;
+        }
+
+        void escribirAtras(int centro, int minutos, int siguiente) {
+            marcaAtras[centro] = consultaActual;
+            minutosAtras[centro] = minutos;
+            siguienteAtras[centro] = siguiente;
+        }
+
+        /**
+         * Arma la ruta uniendo la mitad hacia adelante (hasta el centro de encuentro) con la mitad hacia atrás.
+         */
+        RutaConsultada armarRuta(int encuentro, long long minutos, bool conMitadAtras) const {
+            RutaConsultada resultado;
+            resultado.minutos = static_cast<int>(minutos);
+            for (int centro = encuentro; centro != -1; centro = previoAdelante[centro]) {
+                resultado.centros.push_back(centro);
+            }
+            std::reverse(resultado.centros.begin(), resultado.centros.end());
+            if (conMitadAtras) {
+                for (int centro = siguienteAtras[encuentro]; centro != -1; centro = siguienteAtras[centro]) {
+                    resultado.centros.push_back(centro);
+                }
+            }
+            return resultado;
+        }
+
+        /**
+         * Dijkstra desde el origen que se detiene al extraer el destino.
+         */
+        RutaConsultada rutaUnidireccional(int centroAguaOrigen, int centroAguaDestino) {
+            const RedCSR& red = G.getRedCSR();
+            escribirAdelante(centroAguaOrigen, 0, -1);
+            colaAdelante.insertar(centroAguaOrigen, 0);
+            while (!colaAdelante.isEmpty()) {
+                int centroAguaActual = colaAdelante.extraerMinimo();
+                centrosAsentados++;
+                if (centroAguaActual == centroAguaDestino) {
+                    return armarRuta(centroAguaDestino, minutosAdelante[centroAguaDestino], false);
+                }
+                int minutosActual = minutosAdelante[centroAguaActual];
+                for (int tuberia = red.inicioAdyacentes[centroAguaActual]; tuberia < red.inicioAdyacentes[centroAguaActual + 1]; ++tuberia) {
+                    if (!red.disponibles[tuberia]) {
+                        continue;
+                    }
+                    int centroAguaVecino = red.destinos[tuberia];
+                    int nuevosMinutos = minutosActual + red.minutos[tuberia];
+                    relajaciones++;
+                    if (nuevosMinutos < leerAdelante(centroAguaVecino)) {
+                        escribirAdelante(centroAguaVecino, nuevosMinutos, centroAguaActual);
+                        colaAdelante.insertarODecrementar(centroAguaVecino, nuevosMinutos);
+                    }
+                }
+            }
+            return RutaConsultada();
+        }
+
+        /**
+         * Búsqueda bidireccional: en cada paso avanza el lado cuya cola tiene el menor mínimo.
+         */
+        RutaConsultada rutaBidireccional(int centroAguaOrigen, int centroAguaDestino) {
+            const RedCSR& red = G.getRedCSR();
+            const RedInversaCSR& inversa = G.getRedInversaCSR();
+            long long mejoresMinutos = LLONG_MAX;
+            int encuentro = -1;
+
+            escribirAdelante(centroAguaOrigen, 0, -1);
+            colaAdelante.insertar(centroAguaOrigen, 0);
+            escribirAtras(centroAguaDestino, 0, -1);
+            colaAtras.insertar(centroAguaDestino, 0);
+            if (centroAguaOrigen == centroAguaDestino) {
+                return armarRuta(centroAguaOrigen, 0, true);
+            }
+
+            while (!colaAdelante.isEmpty() && !colaAtras.isEmpty()) {
+                long long minimoAdelante = colaAdelante.prioridadMinima();
+                long long minimoAtras = colaAtras.prioridadMinima();
+                if (minimoAdelante + minimoAtras >= mejoresMinutos) {
+                    break; // Ningún camino por explorar puede mejorar el mejor encuentro
+                }
+
+                if (minimoAdelante <= minimoAtras) {
+                    int centroAguaActual = colaAdelante.extraerMinimo();
+                    centrosAsentados++;
+                    int minutosActual = minutosAdelante[centroAguaActual];
+                    for (int tuberia = red.inicioAdyacentes[centroAguaActual]; tuberia < red.inicioAdyacentes[centroAguaActual + 1]; ++tuberia) {
+                        if (!red.disponibles[tuberia]) {
+                            continue;
+                        }
+                        int centroAguaVecino = red.destinos[tuberia];
+                        int nuevosMinutos = minutosActual + red.minutos[tuberia];
+                        relajaciones++;
+                        if (nuevosMinutos < leerAdelante(centroAguaVecino)) {
+                            escribirAdelante(centroAguaVecino, nuevosMinutos, centroAguaActual);
+                            colaAdelante.insertarODecrementar(centroAguaVecino, nuevosMinutos);
+                            int minutosRestantes = leerAtras(centroAguaVecino);
+                            if (minutosRestantes != INT_MAX && nuevosMinutos + static_cast<long long>(minutosRestantes) < mejoresMinutos) {
+                                mejoresMinutos = nuevosMinutos + static_cast<long long>(minutosRestantes);
+                                encuentro = centroAguaVecino;
+                            }
+                        }
+                    }
+                } else {
+                    int centroAguaActual = colaAtras.extraerMinimo();
+                    centrosAsentados++;
+                    int minutosActual = minutosAtras[centroAguaActual];
+                    for (int posicion = inversa.inicioEntrantes[centroAguaActual]; posicion < inversa.inicioEntrantes[centroAguaActual + 1]; ++posicion) {
+                        int tuberia = inversa.tuberias[posicion];
+                        if (!red.disponibles[tuberia]) {
+                            continue;
+                        }
+                        int centroAguaVecino = inversa.origenes[posicion];
+                        int nuevosMinutos = minutosActual + red.minutos[tuberia];
+                        relajaciones++;
+                        if (nuevosMinutos < leerAtras(centroAguaVecino)) {
+                            escribirAtras(centroAguaVecino, nuevosMinutos, centroAguaActual);
+                            colaAtras.insertarODecrementar(centroAguaVecino, nuevosMinutos);
+                            int minutosRecorridos = leerAdelante(centroAguaVecino);
+                            if (minutosRecorridos != INT_MAX && nuevosMinutos + static_cast<long long>(minutosRecorridos) < mejoresMinutos) {
+                                mejoresMinutos = nuevosMinutos + static_cast<long long>(minutosRecorridos);
+                                encuentro = centroAguaVecino;
+                            }
+                        }
+                    }
+                }
+            }
+
+            if (encuentro == -1) {
+                return RutaConsultada();
+            }
+            return armarRuta(encuentro, mejoresMinutos, true);
+        }
+
+    public:
+        /**
+         * Constructor de la clase ConsultaRuta.
+         *
+         * @param G Red de tuberías de agua sobre la que se harán las consultas.
+         */
+        ConsultaRuta(Rutas& G)
+            : G(G),
+              marcaAdelante(G.getNumeroCentrosAgua(), 0), marcaAtras(G.getNumeroCentrosAgua(), 0),
+              minutosAdelante(G.getNumeroCentrosAgua()), minutosAtras(G.getNumeroCentrosAgua()),
+              previoAdelante(G.getNumeroCentrosAgua()), siguienteAtras(G.getNumeroCentrosAgua()),
+              colaAdelante(G.getNumeroCentrosAgua()), colaAtras(G.getNumeroCentrosAgua()) {}
+
+        /**
+         * Calcula la ruta más corta entre dos centros de agua. Los índices no se validan: quien llama debe comprobar
+         * que estén en [0, getNumeroCentrosAgua()) de la red, como hacen el menú y ProcesadorLotes.
+         *
+         * @param centroAguaOrigen Índice del centro de agua de origen.
+         * @param centroAguaDestino Índice del centro de agua de destino.
+         * @param bidireccional Si es verdadero busca a la vez desde el origen y desde el destino.
+         * @return Minutos y centros de la ruta; minutos es INT_MAX y la ruta está vacía si no hay camino.
+         */
+        RutaConsultada ruta(int centroAguaOrigen, int centroAguaDestino, bool bidireccional = false) {
+            INSTRUMENTAR_FASE(FaseConsultaRuta);
+            nuevaConsulta();
+            RutaConsultada resultado = bidireccional ? rutaBidireccional(centroAguaOrigen, centroAguaDestino)
+                                                     : rutaUnidireccional(centroAguaOrigen, centroAguaDestino);
+            INSTRUMENTAR_SUMAR(EventoCentroAsentado, centrosAsentados);
+            INSTRUMENTAR_SUMAR(EventoRelajacion, relajaciones);
+            return resultado;
+        }
+
+        /**
+         * Obtiene la cantidad de centros extraídos de las colas en la última consulta.
+         */
+        long long getCentrosAsentados() const {
+            return centrosAsentados;
+        }
+
+        /**
+         * Obtiene la cantidad de tuberías relajadas en la última consulta.
+         */
+        long long getRelajaciones() const {
+            return relajaciones;
+        }
+};
+
+#endif // CONSULTA_RUTA_H
@@ -0,0 +1,368 @@
+#ifndef CONTINGENCIA_H
+#define CONTINGENCIA_H
+
+#include <vector>
+#include <climits>
+#include <utility>
+#include <memory>
+#include <algorithm>
+#include "rutas.h"
+#include "cola_prioridad.h"
+#include "pool_hilos.h"
+#include "instrumentacion.h"
+
+/*Análisis de contingencias N-1: qué pasa con el abastecimiento si se rompe una sola tubería. Para cada tubería
+  analizada se calcula cuántos centros quedan sin camino desde los orígenes y cuántos minutos más tardan en llegar
+  los que siguen abastecidos, y las tuberías se ordenan de la más crítica a la menos crítica.
+
+  Los orígenes abastecen juntos a la red: cada centro recibe agua del origen más cercano, así que el árbol base es
+  un bosque de rutas más cortas con una raíz por origen (con un solo origen es el árbol de Dijkstra).
+
+  Cada escenario lee la red compartida a través de RedConFalla, una vista que solo cambia la disponibilidad de la
+  tubería rota, sin copiar la red ni modificar Rutas; por eso los escenarios corren en paralelo sobre el pool. Además
+  reutilizan el árbol base, como ArbolRutasDinamico::repararTrasEliminacion:
+   - si la tubería rota no es del árbol, ninguna ruta más corta cambia y el escenario no cuesta nada;
+   - si lo es, solo el subárbol que colgaba de ella pierde su ruta. El árbol base guarda sus centros en preorden,
+     así que el subárbol es un tramo contiguo y saber si un centro está en él cuesta una comparación. Sus centros
+     toman la mejor tubería entrante desde fuera del subárbol y una búsqueda de Dijkstra limitada a ellos los termina
+     de recalcular. */
+
+/**
+ * Estructura DisponibilidadConFalla
+ *
+ * Disponibilidad de las tuberías de una red con una tubería rota: se indexa igual que RedCSR::disponibles.
+ */
+struct DisponibilidadConFalla {
+    const std::vector<char>& base; // Disponibilidad de la red compartida
+    int tuberiaRota; // Posición en RedCSR de la tubería rota (-1 si ninguna)
+
+    char operator[](int tuberia) const {
+        return tuberia != tuberiaRota && base[tuberia];
+    }
+};
+
+/**
+ * Estructura RedConFalla
+ *
+ * Vista de solo lectura de una instantánea CSR con una tubería rota. Tiene los mismos arreglos indexables que RedCSR,
+ * así que sirve también para EspacioDijkstra::ejecutar (por ejemplo para recalcular un escenario desde cero).
+ */
+struct RedConFalla {
+    const std::vector<int>& inicioAdyacentes; // Los de la red compartida
+    const std::vector<int>& destinos; // Los de la red compartida
+    const std::vector<int>& minutos; // Los de la red compartida
+    DisponibilidadConFalla disponibles; // Los de la red compartida salvo la tubería rota
+
+    RedConFalla(const RedCSR& red, int tuberiaRota)
+        : inicioAdyacentes(red.inicioAdyacentes), destinos(red.destinos), minutos(red.minutos),
+          disponibles{red.disponibles, tuberiaRota} {}
+};
+
+/**
+ * Estructura ImpactoFalla
+ *
+ * Consecuencias de romper una tubería, medidas contra el árbol base.
+ */
+struct ImpactoFalla {
+    int u; // Centro de agua de origen de la tubería
+    int v; // Centro de agua de destino de la tubería
+    int centrosPerdidos = 0; // Centros abastecidos que se quedan sin camino desde los orígenes
+    long long minutosAdicionales = 0; // Minutos que se suman entre los centros que siguen abastecidos
+    int centrosRecalculados = 0; // Centros del subárbol que colgaba de la tubería (0 si no era del árbol)
+};
+
+/**
+ * Estructura ResultadoContingencia
+ *
+ * Árbol base y el impacto de cada tubería analizada, de la más crítica a la menos crítica: primero las que dejan más
+ * centros sin abastecer y, a igualdad, las que suman más minutos.
+ */
+struct ResultadoContingencia {
+    std::vector<int> origenes; // Orígenes sin repetir
+    long long minutosTotales = 0; // Suma de los minutos hacia los centros abastecidos, sin fallas
+    int centrosInalcanzables = 0; // Centros sin camino desde ningún origen, sin fallas
+    std::vector<ImpactoFalla> impactos; // Una entrada por tubería analizada, ordenadas por criticidad
+    int tuberiasCriticas = 0; // Tuberías cuya falla deja centros sin abastecer o suma minutos
+    long long centrosRecalculados = 0; // Centros recalculados en todos los escenarios
+};
+
+/**
+ * Clase AnalisisContingencia
+ *
+ * Árbol base de los orígenes sobre una instantánea CSR y la reparación de cada escenario de falla. El árbol base es de
+ * solo lectura después de construirlo; cada hilo repara con su propio EspacioEscenario.
+ */
+class AnalisisContingencia {
+    public:
+        /**
+         * Buffers de un escenario, reutilizados entre los escenarios de un mismo hilo.
+         */
+        struct EspacioEscenario {
+            std::vector<int> minutos; // Tiempo acumulado de los centros del subárbol durante la reparación
+            ColaPrioridadIndexada<> colaPrioridad; // Cola de la búsqueda limitada al subárbol
+
+            explicit EspacioEscenario(int numeroCentrosAgua) : minutos(numeroCentrosAgua, INT_MAX), colaPrioridad(numeroCentrosAgua) {}
+        };
+
+    private:
+        const RedCSR& red; // Instantánea de la red compartida
+        const RedInversaCSR& inversa; // Tuberías entrantes de cada centro
+        std::vector<int> minutosBase; // Tiempo acumulado mínimo desde el origen más cercano (INT_MAX sin camino)
+        std::vector<int> tuberiaArbol; // Posición en RedCSR de la tubería del árbol que llega a cada centro (-1 si ninguna)
+        std::vector<int> preorden; // Centros abastecidos en preorden del bosque
+        std::vector<int> posicionPreorden; // Posición de cada centro en preorden (-1 si no está abastecido)
+        std::vector<int> tamanoSubarbol; // Centros del subárbol que cuelga de cada centro, incluido él
+
+    public:
+        /**
+         * Calcula el bosque de rutas más cortas desde los orígenes y lo ordena en preorden.
+         *
+         * @param red Instantánea de la red; debe seguir viva y sin cambios mientras se use el análisis.
+         * @param inversa Red inversa de la misma instantánea.
+         * @param origenes Centros de agua de origen (no vacío).
+         */
+        AnalisisContingencia(const RedCSR& red, const RedInversaCSR& inversa, const std::vector<int>& origenes)
+            : red(red), inversa(inversa) {
+            int numeroCentrosAgua = static_cast<int>(red.inicioAdyacentes.size()) - 1;
+            minutosBase.assign(numeroCentrosAgua, INT_MAX);
+            tuberiaArbol.assign(numeroCentrosAgua, -1);
+
+            // Dijkstra con todos los orígenes en la cola a 0 minutos
+            ColaPrioridadIndexada<> colaPrioridad(numeroCentrosAgua);
+            for (int origen : origenes) {
+                if (minutosBase[origen] != 0) {
+                    minutosBase[origen] = 0;
+                    colaPrioridad.insertar(origen, 0);
+                }
+            }
+            std::vector<int> asentados;
+            while (!colaPrioridad.isEmpty()) {
+                int x = colaPrioridad.extraerMinimo();
+                asentados.push_back(x);
+                for (int tuberia = red.inicioAdyacentes[x]; tuberia < red.inicioAdyacentes[x + 1]; ++tuberia) {
+                    int y = red.destinos[tuberia];
+                    if (red.disponibles[tuberia] && minutosBase[x] + red.minutos[tuberia] < minutosBase[y]) {
+                        minutosBase[y] = minutosBase[x] + red.minutos[tuberia];
+                        tuberiaArbol[y] = tuberia;
+                        colaPrioridad.insertarODecrementar(y, minutosBase[y]);
+                    }
+                }
+            }
+
+            // Hijos de cada centro en el bosque, agrupados por padre con un conteo
+            std::vector<int> inicioHijos(numeroCentrosAgua + 1, 0);
+            std::vector<int> padre(numeroCentrosAgua, -1);
+            for (int x : asentados) {
+                for (int tuberia = red.inicioAdyacentes[x]; tuberia < red.inicioAdyacentes[x + 1]; ++tuberia) {
+                    if (tuberiaArbol[red.destinos[tuberia]] == tuberia) {
+                        padre[red.destinos[tuberia]] = x;
+                        inicioHijos[x + 1]++;
+                    }
+                }
+            }
+            for (int x = 0; x < numeroCentrosAgua; ++x) {
+                inicioHijos[x + 1] += inicioHijos[x];
+            }
+            std::vector<int> hijos(inicioHijos[numeroCentrosAgua]);
+            std::vector<int> siguiente(inicioHijos.begin(), inicioHijos.end() - 1);
+            for (int y : asentados) {
+                if (padre[y] != -1) {
+                    hijos[siguiente[padre[y]]++] = y;
+                }
+            }
+
+            // Preorden iterativo desde cada raíz y tamaños de los subárboles de abajo hacia arriba
+            posicionPreorden.assign(numeroCentrosAgua, -1);
+            tamanoSubarbol.assign(numeroCentrosAgua, 0);
+            preorden.reserve(asentados.size());
+            std::vector<int> pila;
+            for (int raiz : asentados) {
+                if (padre[raiz] != -1) {
+                    continue;
+                }
+                pila.push_back(raiz);
+                while (!pila.empty()) {
+                    int x = pila.back();
+                    pila.pop_back();
+                    posicionPreorden[x] = static_cast<int>(preorden.size());
+                    preorden.push_back(x);
+                    for (int hijo = inicioHijos[x]; hijo < inicioHijos[x + 1]; ++hijo) {
+                        pila.push_back(hijos[hijo]);
+                    }
+                }
+            }
+            for (auto it = preorden.rbegin(); it != preorden.rend(); ++it) {
+                tamanoSubarbol[*it]++;
+                if (padre[*it] != -1) {
+                    tamanoSubarbol[padre[*it]] += tamanoSubarbol[*it];
+                }
+            }
+        }
+
+        /**
+         * Obtiene el tiempo acumulado mínimo de cada centro sin fallas (INT_MAX si no está abastecido).
+         */
+        const std::vector<int>& getMinutosBase() const {
+            return minutosBase;
+        }
+
+        /**
+         * Obtiene la cantidad de centros abastecidos sin fallas.
+         */
+        int getNumeroAbastecidos() const {
+            return static_cast<int>(preorden.size());
+        }
+
+        /**
+         * Calcula el impacto de romper una tubería reparando solo el subárbol que colgaba de ella.
+         *
+         * @param tuberia Posición en RedCSR de la tubería rota.
+         * @param espacio Buffers del hilo que evalúa el escenario.
+         * @param impacto Donde se escriben centrosPerdidos, minutosAdicionales y centrosRecalculados.
+         */
+        void evaluarFalla(int tuberia, EspacioEscenario& espacio, ImpactoFalla& impacto) const {
+            impacto.centrosPerdidos = 0;
+            impacto.minutosAdicionales = 0;
+            impacto.centrosRecalculados = 0;
+            int v = red.destinos[tuberia];
+            if (tuberiaArbol[v] != tuberia) {
+                return;
+            }
+            RedConFalla vista(red, tuberia);
+            const int inicioSubarbol = posicionPreorden[v];
+            const int finSubarbol = inicioSubarbol + tamanoSubarbol[v];
+            auto enSubarbol = [&](int centro) {
+                int posicion = posicionPreorden[centro];
+                return posicion >= inicioSubarbol && posicion < finSubarbol;
+            };
+            std::vector<int>& minutos = espacio.minutos;
+            ColaPrioridadIndexada<>& colaPrioridad = espacio.colaPrioridad;
+
+            // Cada centro del subárbol toma la mejor tubería entrante desde un centro abastecido de fuera
+            for (int posicion = inicioSubarbol; posicion < finSubarbol; ++posicion) {
+                int y = preorden[posicion];
+                int mejor = INT_MAX;
+                for (int entrante = inversa.inicioEntrantes[y]; entrante < inversa.inicioEntrantes[y + 1]; ++entrante) {
+                    int x = inversa.origenes[entrante];
+                    int tuberiaEntrante = inversa.tuberias[entrante];
+                    if (!vista.disponibles[tuberiaEntrante] || minutosBase[x] == INT_MAX || enSubarbol(x)) {
+                        continue;
+                    }
+                    mejor = std::min(mejor, minutosBase[x] + vista.minutos[tuberiaEntrante]);
+                }
+                minutos[y] = mejor;
+                if (mejor != INT_MAX) {
+                    colaPrioridad.insertar(y, mejor);
+                }
+            }
+
+            // Dijkstra limitado al subárbol: las tuberías hacia fuera no pueden mejorar centros que no perdieron su ruta
+            while (!colaPrioridad.isEmpty()) {
+                int x = colaPrioridad.extraerMinimo();
+                for (int saliente = vista.inicioAdyacentes[x]; saliente < vista.inicioAdyacentes[x + 1]; ++saliente) {
+                    int y = vista.destinos[saliente];
+                    if (!vista.disponibles[saliente] || !enSubarbol(y)) {
+                        continue;
+                    }
+                    int nuevosMinutos = minutos[x] + vista.minutos[saliente];
+                    if (nuevosMinutos < minutos[y]) {
+                        minutos[y] = nuevosMinutos;
+                        colaPrioridad.insertarODecrementar(y, nuevosMinutos);
+                    }
+                }
+            }
+
+            for (int posicion = inicioSubarbol; posicion < finSubarbol; ++posicion) {
+                int y = preorden[posicion];
+                if (minutos[y] == INT_MAX) {
+                    impacto.centrosPerdidos++;
+                } else {
+                    impacto.minutosAdicionales += minutos[y] - minutosBase[y];
+                }
+                minutos[y] = INT_MAX; // Deja el buffer listo para el siguiente escenario
+            }
+            impacto.centrosRecalculados = finSubarbol - inicioSubarbol;
+        }
+};
+
+/**
+ * Analiza en paralelo la falla de cada tubería por separado y ordena las tuberías por criticidad.
+ *
+ * @param G Red de tuberías de agua; no se modifica.
+ * @param pool Pool de hilos que reparte los escenarios.
+ * @param origenes Centros de agua de origen que abastecen juntos a la red (no vacío).
+ * @param tuberias Tuberías (u, v) a analizar; vacío analiza todas. Las que no existen o ya están deshabilitadas se
+ *                 omiten, porque no pueden romperse.
+ * @return Resumen sin fallas e impacto de cada tubería analizada.
+ */
+ResultadoContingencia analizarContingencias(Rutas& G, PoolHilos& pool, std::vector<int> origenes,
+                                            const std::vector<std::pair<int, int>>& tuberias = {}) {
+    INSTRUMENTAR_FASE(FaseContingencia);
+    int numeroCentrosAgua = G.getNumeroCentrosAgua();
+    const RedCSR& red = G.getRedCSR();
+    const RedInversaCSR& inversa = G.getRedInversaCSR();
+    ResultadoContingencia resultado;
+    std::sort(origenes.begin(), origenes.end());
+    origenes.erase(std::unique(origenes.begin(), origenes.end()), origenes.end());
+    resultado.origenes = origenes;
+
+    AnalisisContingencia analisis(red, inversa, origenes);
+    for (int minutosCentro : analisis.getMinutosBase()) {
+        if (minutosCentro != INT_MAX) {
+            resultado.minutosTotales += minutosCentro;
+        }
+    }
+    resultado.centrosInalcanzables = numeroCentrosAgua - analisis.getNumeroAbastecidos();
+
+    // Posiciones en RedCSR de las tuberías que pueden romperse
+    std::vector<int> posiciones;
+    if (tuberias.empty()) {
+        for (int tuberia = 0; tuberia < static_cast<int>(red.destinos.size()); ++tuberia) {
+            if (red.disponibles[tuberia]) {
+                posiciones.push_back(tuberia);
+            }
+        }
+    } else {
+        for (const auto& [u, v] : tuberias) {
+            int tuberia = red.buscarTuberia(u, v);
+            if (tuberia != -1 && red.disponibles[tuberia]) {
+                posiciones.push_back(tuberia);
+            }
+        }
+        std::sort(posiciones.begin(), posiciones.end());
+        posiciones.erase(std::unique(posiciones.begin(), posiciones.end()), posiciones.end());
+    }
+    resultado.impactos.resize(posiciones.size());
+    for (size_t i = 0; i < posiciones.size(); ++i) {
+        int tuberia = posiciones[i];
+        resultado.impactos[i].u = static_cast<int>(std::upper_bound(red.inicioAdyacentes.begin(), red.inicioAdyacentes.end(), tuberia) -
+                                                   red.inicioAdyacentes.begin()) - 1;
+        resultado.impactos[i].v = red.destinos[tuberia];
+    }
+
+    // Escenarios en paralelo: cada hilo con sus buffers, creados al primer escenario que le toca
+    std::vector<std::unique_ptr<AnalisisContingencia::EspacioEscenario>> espacios(pool.getNumeroHilos());
+    pool.paraCada(static_cast<int>(posiciones.size()), [&](int hilo, int indice) {
+        if (!espacios[hilo]) {
+            espacios[hilo] = std::make_unique<AnalisisContingencia::EspacioEscenario>(numeroCentrosAgua);
+        }
+        analisis.evaluarFalla(posiciones[indice], *espacios[hilo], resultado.impactos[indice]);
+    });
+
+    for (const ImpactoFalla& impacto : resultado.impactos) {
+        resultado.centrosRecalculados += impacto.centrosRecalculados;
+        resultado.tuberiasCriticas += impacto.centrosPerdidos > 0 || impacto.minutosAdicionales > 0;
+    }
+    std::sort(resultado.impactos.begin(), resultado.impactos.end(), [](const ImpactoFalla& a, const ImpactoFalla& b) {
+        if (a.centrosPerdidos != b.centrosPerdidos) {
+            return a.centrosPerdidos > b.centrosPerdidos;
+        }
+        if (a.minutosAdicionales != b.minutosAdicionales) {
+            return a.minutosAdicionales > b.minutosAdicionales;
+        }
+        return a.u != b.u ? a.u < b.u : a.v < b.v;
+    });
+    return resultado;
+}
+
+#endif // CONTINGENCIA_H
@@ -0,0 +1,42 @@
+#include <iostream>
+#include <string>
+#include "rutas.h"
+#include "pool_hilos.h"
+#include "importador.h"
+#include "formato_binario.h"
+
+/*Convierte una lista de tuberías en texto (u,v,minutos[,disponible] por línea) al formato binario que
+  menu_tuberias puede abrir con memoria mapeada. La lista se importa por bloques y en paralelo.
+  Compilar con: g++ -O2 -std=c++17 -pthread -o convertir_red convertir_red.cpp
+  Uso: convertir_red <lista_tuberias.txt> <red.bin> [numero_centros_agua] */
+
+int main(int argc, char* argv[]) {
+    if (argc != 3 && argc != 4) {
+        std::cerr << "Uso: " << argv[0] << " <lista_tuberias.txt> <red.bin> [numero_centros_agua]" << std::endl;
+        return 1;
+    }
+    int numeroCentrosAgua = argc == 4 ? std::atoi(argv[3]) : 0;
+
+    PoolHilos pool;
+    ImportadorTuberias importador(pool);
+    RedCSR red;
+    InformeImportacion informe;
+    bool importada = importador.importar(argv[1], numeroCentrosAgua, red, informe);
+    for (const std::string& problema : informe.problemas) {
+        std::cerr << problema << std::endl;
+    }
+    if (!importada) {
+        return 1;
+    }
+    std::cout << "Importadas " << informe.tuberias << " tuberias de " << informe.lineas << " lineas (" << informe.bytesLeidos / (1024.0 * 1024.0)
+              << " MB) en " << informe.segundos << " s: " << informe.megabytesPorSegundo << " MB/s con " << pool.getNumeroHilos() << " hilos." << std::endl;
+    std::cout << "Lineas invalidas: " << informe.lineasInvalidas << ", centros fuera de rango: " << informe.centrosFueraDeRango
+              << ", tuberias repetidas: " << informe.tuberiasDuplicadas << "." << std::endl;
+
+    if (!guardarRedBinaria(red, argv[2])) {
+        std::cerr << "No se pudo escribir el archivo " << argv[2] << std::endl;
+        return 1;
+    }
+    std::cout << "Red guardada en " << argv[2] << " con " << red.inicioAdyacentes.size() - 1 << " centros de agua." << std::endl;
+    return 0;
+}
@@ -0,0 +1,205 @@
+#ifndef DELTA_STEPPING_H
+#define DELTA_STEPPING_H
+
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <functional>
+#include "rutas.h"
+#include "pool_hilos.h"
+
+/*Rutas más cortas desde un origen en paralelo con delta-stepping (Meyer y Sanders). Los centros se agrupan en
+  cubetas de ancho delta según sus minutos acumulados; todas las entradas de la cubeta actual se procesan a la vez
+  repartidas entre los hilos del pool. Dentro de una cubeta primero se relajan, en fases, las tuberías livianas
+  (minutos <= delta), que pueden volver a llenar la misma cubeta; cuando queda vacía se relajan una sola vez las
+  tuberías pesadas de los centros asentados en ella.
+
+  Los minutos y el centro previo de cada centro se guardan juntos en un entero atómico de 64 bits (minutos en la
+  mitad alta), así una relajación los actualiza con un solo compare-and-swap y nunca quedan desparejados. */
+
+/**
+ * Empaqueta minutos y centro previo en un entero de 64 bits; los minutos van en la mitad alta.
+ */
+uint64_t empaquetarMinutosPrevio(int minutos, int previo) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(minutos)) << 32) | static_cast<uint32_t>(previo);
+}
+
+const int cubetasMaximas = 1 << 16; // Cubetas del anillo por hilo; un delta que necesitaría más se agranda
+
+/**
+ * Elige un ancho de cubeta razonable: el tiempo máximo de una tubería dividido por el grado medio de la red.
+ * Con delta grande hay pocas cubetas y mucho paralelismo pero más trabajo repetido; con delta = 1 es Dijkstra
+ * con cubetas (poco paralelismo). Cualquier delta, elegido aquí o indicado, se agranda si el anillo necesitaría más
+ * de cubetasMaximas cubetas (minutosMaximo / delta + 2), para no reservar millones de cubetas vacías por hilo.
+ */
+int elegirDeltaAutomatico(const RedCSR& red) {
+    int numeroCentrosAgua = static_cast<int>(red.inicioAdyacentes.size()) - 1;
+    int minutosMaximo = 1;
+    for (int minutos : red.minutos) {
+        minutosMaximo = std::max(minutosMaximo, minutos);
+    }
+    long long gradoMedio = std::max<long long>(1, static_cast<long long>(red.destinos.size()) / std::max(1, numeroCentrosAgua));
+    return static_cast<int>(std::max<long long>(1, minutosMaximo / gradoMedio));
+}
+
+/**
+ * Rutas más cortas desde un origen con delta-stepping paralelo. Devuelve el mismo par que Dijkstra, así que el
+ * resultado sirve directamente para reconstruirRuta. Los minutos coinciden con Dijkstra; ante dos rutas igual de
+ * cortas el centro previo puede ser otro.
+ *
+ * @param G Red de tuberías de agua.
+ * @param centroAguaOrigen Índice del centro de agua de origen.
+ * @param pool Hilos que procesan cada cubeta.
+ * @param delta Ancho de las cubetas en minutos; 0 lo elige según la red. Se agranda si el anillo superaría
+ *              cubetasMaximas (ver elegirDeltaAutomatico).
+ * @return Par con los minutos acumulados hasta cada centro (INT_MAX si no hay camino) y el centro previo de cada uno.
+ */
+std::pair<std::vector<int>, std::vector<int>> DijkstraDeltaStepping(Rutas& G, int centroAguaOrigen, PoolHilos& pool, int delta = 0) {
+    // Centro pendiente en una cubeta, con los minutos que tenía al entrar: si luego bajaron, la entrada está vencida
+    struct Entrada {
+        int centro;
+        int minutos;
+    };
+    // Cubetas y centros asentados propios de cada hilo
+    struct alignas(64) EspacioHilo {
+        std::vector<std::vector<Entrada>> cubetas;
+        std::vector<int> asentados;
+    };
+    const int tamanoTarea = 256; // Entradas por tarea del pool
+    const uint64_t sinCamino = empaquetarMinutosPrevio(INT_MAX, -1);
+
+    const RedCSR& red = G.getRedCSR();
+    int numeroCentrosAgua = G.getNumeroCentrosAgua();
+    int numeroHilos = pool.getNumeroHilos();
+    if (delta <= 0) {
+        delta = elegirDeltaAutomatico(red);
+    }
+    int minutosMaximo = 0;
+    for (int minutos : red.minutos) {
+        minutosMaximo = std::max(minutosMaximo, minutos);
+    }
+    // Una relajación desde la cubeta i cae a lo sumo en la cubeta i + minutosMaximo / delta: basta un anillo de cubetas
+    if (minutosMaximo / delta + 2LL > cubetasMaximas) {
+        delta = minutosMaximo / (cubetasMaximas - 2) + 1;
+    }
+    int numeroCubetas = static_cast<int>(minutosMaximo / delta + 2LL);
+
+    std::vector<std::atomic<uint64_t>> minutosPrevio(numeroCentrosAgua);
+    for (auto& valor : minutosPrevio) {
+        valor.store(sinCamino, std::memory_order_relaxed);
+    }
+    std::vector<EspacioHilo> espacios(numeroHilos);
+    for (EspacioHilo& espacio : espacios) {
+        espacio.cubetas.resize(numeroCubetas);
+    }
+
+    // Baja los minutos de un centro si la ruta nueva es estrictamente mejor; solo entonces lo agrega a su cubeta.
+    // Exigir una mejora estricta evita ciclos de previos con tuberías de 0 minutos.
+    auto relajar = [&](EspacioHilo& espacio, int centro, long long minutos, int previo) {
+        if (minutos >= INT_MAX) {
+            return;
+        }
+        uint64_t actual = minutosPrevio[centro].load(std::memory_order_relaxed);
+        uint64_t nuevo = empaquetarMinutosPrevio(static_cast<int>(minutos), previo);
+        while ((nuevo >> 32) < (actual >> 32)) {
+            if (minutosPrevio[centro].compare_exchange_weak(actual, nuevo, std::memory_order_relaxed)) {
+                espacio.cubetas[(minutos / delta) % numeroCubetas].push_back({centro, static_cast<int>(minutos)});
+                return;
+            }
+        }
+    };
+
+    // Reparte entre los hilos las entradas de varias listas (una por hilo) sin copiarlas a una sola
+    std::vector<std::vector<Entrada>> frontera(numeroHilos);
+    std::vector<long long> inicioLista(numeroHilos + 1);
+    auto paraCadaEntrada = [&](const std::function<void(EspacioHilo&, const Entrada&)>& funcion) {
+        inicioLista[0] = 0;
+        for (int lista = 0; lista < numeroHilos; ++lista) {
+            inicioLista[lista + 1] = inicioLista[lista] + static_cast<long long>(frontera[lista].size());
+        }
+        long long total = inicioLista[numeroHilos];
+        int numeroTareas = static_cast<int>((total + tamanoTarea - 1) / tamanoTarea);
+        pool.paraCada(numeroTareas, [&](int hilo, int tarea) {
+            long long inicio = static_cast<long long>(tarea) * tamanoTarea;
+            long long fin = std::min(total, inicio + tamanoTarea);
+            int lista = static_cast<int>(std::upper_bound(inicioLista.begin(), inicioLista.end(), inicio) - inicioLista.begin()) - 1;
+            for (long long posicion = inicio; posicion < fin; ++posicion) {
+                while (posicion >= inicioLista[lista + 1]) {
+                    lista++;
+                }
+                funcion(espacios[hilo], frontera[lista][posicion - inicioLista[lista]]);
+            }
+        });
+    };
+
+    EspacioHilo& espacioInicial = espacios[0];
+    relajar(espacioInicial, centroAguaOrigen, 0, -1);
+
+    int cubetasVaciasSeguidas = 0;
+    for (long long cubeta = 0; cubetasVaciasSeguidas < numeroCubetas; ++cubeta) {
+        int indiceCubeta = static_cast<int>(cubeta % numeroCubetas);
+        bool huboEntradas = false;
+
+        // Fases de tuberías livianas hasta que la cubeta quede vacía
+        while (true) {
+            long long pendientes = 0;
+            for (int hilo = 0; hilo < numeroHilos; ++hilo) {
+                frontera[hilo].clear();
+                frontera[hilo].swap(espacios[hilo].cubetas[indiceCubeta]);
+                pendientes += static_cast<long long>(frontera[hilo].size());
+            }
+            if (pendientes == 0) {
+                break;
+            }
+            huboEntradas = true;
+            paraCadaEntrada([&](EspacioHilo& espacio, const Entrada& entrada) {
+                int minutosActual = static_cast<int>(minutosPrevio[entrada.centro].load(std::memory_order_relaxed) >> 32);
+                if (minutosActual != entrada.minutos) {
+                    return; // Entrada vencida: el centro ya entró de nuevo con menos minutos
+                }
+                espacio.asentados.push_back(entrada.centro);
+                for (int tuberia = red.inicioAdyacentes[entrada.centro]; tuberia < red.inicioAdyacentes[entrada.centro + 1]; ++tuberia) {
+                    if (red.disponibles[tuberia] && red.minutos[tuberia] <= delta) {
+                        relajar(espacio, red.destinos[tuberia], static_cast<long long>(minutosActual) + red.minutos[tuberia], entrada.centro);
+                    }
+                }
+            });
+        }
+
+        if (!huboEntradas) {
+            cubetasVaciasSeguidas++;
+            continue;
+        }
+        cubetasVaciasSeguidas = 0;
+
+        // Tuberías pesadas de los centros asentados en esta cubeta: caen siempre en cubetas posteriores
+        for (int hilo = 0; hilo < numeroHilos; ++hilo) {
+            frontera[hilo].clear();
+            for (int centro : espacios[hilo].asentados) {
+                frontera[hilo].push_back({centro, 0});
+            }
+            espacios[hilo].asentados.clear();
+        }
+        paraCadaEntrada([&](EspacioHilo& espacio, const Entrada& entrada) {
+            int minutosActual = static_cast<int>(minutosPrevio[entrada.centro].load(std::memory_order_relaxed) >> 32);
+            for (int tuberia = red.inicioAdyacentes[entrada.centro]; tuberia < red.inicioAdyacentes[entrada.centro + 1]; ++tuberia) {
+                if (red.disponibles[tuberia] && red.minutos[tuberia] > delta) {
+                    relajar(espacio, red.destinos[tuberia], static_cast<long long>(minutosActual) + red.minutos[tuberia], entrada.centro);
+                }
+            }
+        });
+    }
+
+    std::vector<int> minutosParaLlegarAcumulados(numeroCentrosAgua);
+    std::vector<int> centrosAguaPrevio(numeroCentrosAgua);
+    for (int centro = 0; centro < numeroCentrosAgua; ++centro) {
+        uint64_t valor = minutosPrevio[centro].load(std::memory_order_relaxed);
+        minutosParaLlegarAcumulados[centro] = static_cast<int>(valor >> 32);
+        centrosAguaPrevio[centro] = static_cast<int>(static_cast<uint32_t>(valor));
+    }
+    return {minutosParaLlegarAcumulados, centrosAguaPrevio};
+}
+
+#endif // DELTA_STEPPING_H
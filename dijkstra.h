@@ -0,0 +1,267 @@
+#ifndef DIJKSTRA_H
+#define DIJKSTRA_H
+
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include "rutas.h"
+#include "cola_prioridad.h"
+#include "instrumentacion.h"
+
+/**
+ * Clase EspacioDijkstraCon
+ *
+ * Buffers reutilizables de una búsqueda de Dijkstra: tiempos acumulados, centros previos, marcas de visitado y la
+ * cola de prioridad. Se reservan una sola vez con el tamaño de la red; cada búsqueda marca los centros que toca con
+ * su número de búsqueda, así un centro con una marca anterior vale sinCamino sin haber tenido que reiniciarlo. Reiniciar
+ * cuesta lo mismo que los centros tocados en la búsqueda anterior y las búsquedas repetidas no piden memoria.
+ *
+ * Quien ejecuta muchas búsquedas seguidas (por ejemplo un hilo del cálculo de todos los orígenes) usa el mismo espacio
+ * en todas. La red se lee siempre por referencia.
+ *
+ * @tparam Cola Política de cola de prioridad: cualquier cola con insertar, extraerMinimo, insertarODecrementar,
+ *              vaciar e isEmpty (ColaMinutos, ColaCubetasDial, ColaRadix, ColaPrioridadIndexada o ColaPrioridad).
+ *              EspacioDijkstra usa ColaMinutos, que elige entre las cubetas de Dial y el montículo radix. Sus
+ *              prioridades deben ser del tipo Tipos::Distancia.
+ * @tparam Tipos Tipos de los centros y los minutos de la red (ver tipos_red.h); int en EspacioDijkstra.
+ */
+template <typename Cola, typename Tipos = TiposRedPredeterminados>
+class EspacioDijkstraCon {
+    public:
+        using Centro = typename Tipos::Centro;
+        using Distancia = typename Tipos::Distancia;
+
+    private:
+        int numeroCentrosAgua; // Número de centros de agua de la red
+        unsigned int busquedaActual = 0; // Marca base de la búsqueda en curso (par; base + 1 indica visitado)
+        std::vector<unsigned int> marcas; // Marca de cada centro: base si se tocó en la búsqueda actual, base + 1 si además se visitó
+        std::vector<Distancia> minutosParaLlegarAcumulados; // Tiempo acumulado mínimo, válido solo para los centros tocados
+        std::vector<Centro> centrosAguaPrevio; // Centro de agua previo, válido solo para los centros tocados
+        std::vector<Centro> asentados; // Centros visitados en la búsqueda actual, en el orden en que salieron de la cola
+        Cola colaPrioridad; // Cola de prioridad con capacidad para todos los centros de agua
+
+        /**
+         * Comienza una nueva búsqueda; solo cuando el contador da la vuelta se limpian las marcas completas.
+         */
+        void nuevaBusqueda() {
+            busquedaActual += 2;
+            if (busquedaActual == 0) {
+                std::fill(marcas.begin(), marcas.end(), 0);
+                busquedaActual = 2;
+            }
+            asentados.clear();
+            colaPrioridad.vaciar();
+        }
+
+    public:
+        /**
+         * Constructor de la clase EspacioDijkstraCon.
+         *
+         * @param numeroCentrosAgua Número de centros de agua de las redes sobre las que se buscará.
+         * @param minutosMaximo Minutos de la tubería más lenta de esas redes (Rutas::getMinutosMaximo); las colas de
+         *                      minutos eligen con él su implementación. Sin este dato (-1) se usa el montículo radix.
+         */
+        explicit EspacioDijkstraCon(int numeroCentrosAgua, long long minutosMaximo = -1)
+            : numeroCentrosAgua(numeroCentrosAgua), marcas(numeroCentrosAgua, 0), minutosParaLlegarAcumulados(numeroCentrosAgua),
+              centrosAguaPrevio(numeroCentrosAgua), colaPrioridad(crearCola<Cola>(numeroCentrosAgua, minutosMaximo)) {
+            asentados.reserve(numeroCentrosAgua);
+        }
+
+        /**
+         * Ejecuta Dijkstra completo desde un origen sobre la instantánea CSR de la red.
+         *
+         * @tparam Red Cualquier red con los arreglos inicioAdyacentes, destinos, minutos y disponibles indexables
+         *             (RedCSR en memoria o RedCSRMapeada leída de un archivo binario).
+         * @param red Instantánea compacta de la red de tuberías, con el número de centros de este espacio.
+         * @param centroAguaOrigen Índice del centro de agua de origen.
+         * @return Cantidad de relajaciones (tuberías disponibles revisadas hacia centros aún no visitados).
+         */
+        template <typename Red>
+        long long ejecutar(const Red& red, Centro centroAguaOrigen) {
+            return ejecutar(red, centroAguaOrigen, [](Centro, Distancia) { return true; });
+        }
+
+        /**
+         * Ejecuta Dijkstra desde un origen y consulta a continuar después de asentar cada centro; si devuelve false
+         * la búsqueda se detiene ahí. Los centros asentados hasta ese momento conservan su tiempo definitivo.
+         *
+         * @param continuar Función (centroAsentado, minutosAsentado) -> bool. Los centros llegan en orden de
+         *                  minutos creciente, así que minutosAsentado es una cota inferior de los que faltan.
+         * @return Cantidad de relajaciones hechas antes de terminar o detenerse.
+         */
+        template <typename Red, typename Continuar>
+        long long ejecutar(const Red& red, Centro centroAguaOrigen, Continuar&& continuar) {
+            INSTRUMENTAR_FASE(FaseDijkstra);
+            nuevaBusqueda();
+            const unsigned int tocado = busquedaActual;
+            const unsigned int visitado = busquedaActual + 1;
+
+            marcas[centroAguaOrigen] = tocado;
+            minutosParaLlegarAcumulados[centroAguaOrigen] = 0; // Establecer el tiempo acumulado del centro de agua de origen a 0
+            centrosAguaPrevio[centroAguaOrigen] = Tipos::sinCentro;
+            colaPrioridad.insertar(centroAguaOrigen, 0); // Insertar el centro de agua de origen en la cola de prioridad con un tiempo de llegada de 0
+            long long relajaciones = 0; // Contador de tuberías relajadas
+
+            // Mientras la cola de prioridad no esté vacía
+            while (!colaPrioridad.isEmpty()) {
+                Centro centroAguaActual = static_cast<Centro>(colaPrioridad.extraerMinimo()); // Extraer el centro de agua con el menor tiempo acumulado
+                marcas[centroAguaActual] = visitado; // Marcar el centro de agua actual como visitado
+                asentados.push_back(centroAguaActual);
+                INSTRUMENTAR_CONTAR(EventoCentroAsentado);
+                Distancia minutosActual = minutosParaLlegarAcumulados[centroAguaActual];
+                if (!continuar(centroAguaActual, minutosActual)) {
+                    break;
+                }
+
+                // Para cada centro de agua vecino del centro de agua actual
+                for (int tuberia = red.inicioAdyacentes[centroAguaActual]; tuberia < red.inicioAdyacentes[centroAguaActual + 1]; ++tuberia) {
+                    Centro centroAguaVecino = red.destinos[tuberia];
+                    bool disponibilidad = red.disponibles[tuberia]; // Obtener la disponibilidad de la tubería
+                    unsigned int marcaVecino = marcas[centroAguaVecino];
+                    if (disponibilidad && marcaVecino != visitado) { // Si la tubería está disponible y el centro de agua vecino no ha sido visitado
+                        // Calcular el nuevo tiempo acumulado para llegar al centro de agua vecino (sinCamino si no cabe en Distancia)
+                        Distancia nuevosMinutosParaLlegar = Tipos::sumarMinutos(minutosActual, red.minutos[tuberia]);
+                        relajaciones++;
+
+                        // Si el vecino no se había tocado en esta búsqueda o el nuevo tiempo acumulado es menor; una suma
+                        // saturada no cuenta como camino
+                        if (nuevosMinutosParaLlegar != Tipos::sinCamino &&
+                            (marcaVecino != tocado || nuevosMinutosParaLlegar < minutosParaLlegarAcumulados[centroAguaVecino])) {
+                            marcas[centroAguaVecino] = tocado;
+                            minutosParaLlegarAcumulados[centroAguaVecino] = nuevosMinutosParaLlegar; // Actualizar el tiempo acumulado mínimo
+                            centrosAguaPrevio[centroAguaVecino] = centroAguaActual; // Actualizar el centro de agua previo en la ruta más corta
+                            colaPrioridad.insertarODecrementar(centroAguaVecino, nuevosMinutosParaLlegar); // Insertar o actualizar la prioridad del centro de agua vecino
+                        }
+                    }
+                }
+            }
+            INSTRUMENTAR_SUMAR(EventoRelajacion, relajaciones);
+            return relajaciones;
+        }
+
+        /**
+         * Obtiene el número de centros de agua del espacio.
+         */
+        int getNumeroCentrosAgua() const {
+            return numeroCentrosAgua;
+        }
+
+        /**
+         * Obtiene el tiempo acumulado mínimo hacia un centro en la última búsqueda.
+         *
+         * @return Minutos desde el origen, o Tipos::sinCamino (INT_MAX con int) si la búsqueda no llegó al centro.
+         */
+        Distancia getMinutos(Centro centroAgua) const {
+            return marcas[centroAgua] >= busquedaActual ? minutosParaLlegarAcumulados[centroAgua] : Tipos::sinCamino;
+        }
+
+        /**
+         * Obtiene el centro previo de un centro en la ruta más corta de la última búsqueda.
+         *
+         * @return Índice del centro previo, o Tipos::sinCentro (-1 con int) si es el origen o la búsqueda no llegó al centro.
+         */
+        Centro getPrevio(Centro centroAgua) const {
+            return marcas[centroAgua] >= busquedaActual ? centrosAguaPrevio[centroAgua] : Tipos::sinCentro;
+        }
+
+        /**
+         * Obtiene los centros visitados en la última búsqueda, en orden de tiempo acumulado creciente. Son justamente
+         * los centros alcanzables desde el origen, así que recorrerlos cuesta lo que tocó la búsqueda y no la red.
+         */
+        const std::vector<Centro>& getAsentados() const {
+            return asentados;
+        }
+
+        /**
+         * Copia el resultado de la última búsqueda a vectores del tamaño de la red (sinCamino y sinCentro en los centros
+         * sin camino). Los vectores se redimensionan solo si hace falta, así que reutilizarlos tampoco pide memoria.
+         *
+         * @param minutos Vector donde se escriben los tiempos acumulados.
+         * @param previo Vector donde se escriben los centros previos.
+         */
+        void copiarResultado(std::vector<Distancia>& minutos, std::vector<Centro>& previo) const {
+            minutos.assign(numeroCentrosAgua, Tipos::sinCamino);
+            previo.assign(numeroCentrosAgua, Tipos::sinCentro);
+            for (Centro centroAgua : asentados) {
+                minutos[centroAgua] = minutosParaLlegarAcumulados[centroAgua];
+                previo[centroAgua] = centrosAguaPrevio[centroAgua];
+            }
+        }
+};
+
+/**
+ * Espacio de Dijkstra con la cola elegida según los minutos de las tuberías, para redes con los tipos indicados.
+ */
+template <typename Tipos>
+using EspacioDijkstraPara = EspacioDijkstraCon<ColaMinutos<typename Tipos::Distancia>, Tipos>;
+
+/**
+ * Espacio de Dijkstra con la cola elegida según los minutos de las tuberías, para redes con centros y minutos int.
+ */
+using EspacioDijkstra = EspacioDijkstraPara<TiposRedPredeterminados>;
+
+/**
+ * Implementación del algoritmo de Dijkstra para encontrar las rutas más cortas desde un centro de agua de origen
+ * a todos los otros centros de agua en la red.
+ * 
+ * @param G Grafo que representa la red de tuberías de agua (instancia de la clase Rutas); se lee sin copiarlo.
+ * @param centroAguaOrigen Índice del centro de agua de origen desde el cual se calcularán las rutas más cortas.
+ * @return Un par de vectores:
+ *         - El primer vector contiene el tiempo acumulado mínimo para llegar a cada centro de agua desde el centro de agua de origen.
+ *         - El segundo vector contiene el índice del centro de agua anterior para cada centro de agua en la ruta más corta.
+ */
+template <typename Tipos>
+std::pair<std::vector<typename Tipos::Distancia>, std::vector<typename Tipos::Centro>> Dijkstra(RutasCon<Tipos>& G,
+                                                                                                typename Tipos::Centro centroAguaOrigen) {
+    EspacioDijkstraPara<Tipos> espacio(G.getNumeroCentrosAgua(), G.getMinutosMaximo()); // Buffers de la búsqueda
+    espacio.ejecutar(G.getRedCSR(), centroAguaOrigen);
+
+    // Retornar el vector de tiempos acumulados y el vector de centros de agua previos
+    std::vector<typename Tipos::Distancia> minutosParaLlegarAcumulados;
+    std::vector<typename Tipos::Centro> centrosAguaPrevio;
+    espacio.copiarResultado(minutosParaLlegarAcumulados, centrosAguaPrevio);
+    return {std::move(minutosParaLlegarAcumulados), std::move(centrosAguaPrevio)};
+}
+
+/**
+ * Variante de Dijkstra para consultas repetidas: usa un espacio ya reservado y escribe el resultado en vectores del
+ * llamador, así una serie de consultas desde distintos orígenes no pide memoria después de la primera.
+ *
+ * @param G Grafo que representa la red de tuberías de agua.
+ * @param centroAguaOrigen Índice del centro de agua de origen.
+ * @param espacio Buffers de la búsqueda, con el tamaño de la red.
+ * @param minutosParaLlegarAcumulados Vector donde se escribe el tiempo acumulado mínimo para llegar a cada centro de agua.
+ * @param centrosAguaPrevio Vector donde se escribe el centro de agua previo en la ruta más corta.
+ */
+template <typename Tipos, typename Cola>
+void Dijkstra(RutasCon<Tipos>& G, typename Tipos::Centro centroAguaOrigen, EspacioDijkstraCon<Cola, Tipos>& espacio,
+              std::vector<typename Tipos::Distancia>& minutosParaLlegarAcumulados, std::vector<typename Tipos::Centro>& centrosAguaPrevio) {
+    espacio.ejecutar(G.getRedCSR(), centroAguaOrigen);
+    espacio.copiarResultado(minutosParaLlegarAcumulados, centrosAguaPrevio);
+}
+
+/**
+ * Reconstruye la ruta más corta desde el centro de agua de origen hasta el centro de agua destino
+ * utilizando el vector de centros de agua previos calculado por el algoritmo de Dijkstra.
+ * 
+ * @param centrosAguaPrevio Vector que contiene el índice del centro de agua anterior para cada centro de agua en la ruta
+ *                          más corta (centroNulo, -1 con int, en el origen).
+ * @param centroAguaDestino Índice del centro de agua destino al que se quiere llegar.
+ * @return Un vector que contiene la secuencia de centros de agua desde el origen hasta el destino en la ruta más corta.
+ */
+template <typename Centro>
+std::vector<Centro> reconstruirRuta(const std::vector<Centro>& centrosAguaPrevio, typename std::vector<Centro>::value_type centroAguaDestino) {
+    std::vector<Centro> rutaDestino; // Vector para almacenar la ruta desde el origen hasta el destino
+
+    // Recorre el vector de centros de agua previos desde el destino hasta el origen
+    for (Centro centroAguaActual = centroAguaDestino; centroAguaActual != centroNulo<Centro>(); centroAguaActual = centrosAguaPrevio[centroAguaActual]) {
+        rutaDestino.push_back(centroAguaActual); // Agrega el centro de agua actual a la ruta
+    }
+
+    // Invierte el vector para obtener la ruta desde el origen hasta el destino
+    std::reverse(rutaDestino.begin(), rutaDestino.end());
+
+    return rutaDestino; // Retorna la ruta reconstruida
+}
+
+#endif // DIJKSTRA_H
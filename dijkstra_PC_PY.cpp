@@ -1,252 +1,20 @@
 #include <iostream>
 #include <vector>
-#include <map>
-#include <set>
-#include <tuple>
-#include <queue>
-#include <algorithm>
 #include <string>
 #include <climits>
-#include <C:\Users\mauri\AppData\Local\Programs\Python\Python311\include\Python.h> // Asegúrate de que la ruta de la cabecera sea correcta
-
-/**
- * Clase Rutas
- * 
- * Esta clase se utiliza para modelar y gestionar la red de tuberías de distribución de agua entre diferentes centros de agua.
- * Permite la creación de una red de tuberías, la consulta de conexiones entre centros, y la modificación de la disponibilidad de las tuberías.
- */
-class Rutas {
-    private:
-        int centroAgua; // Número total de centros de agua en la red.
-        std::vector<std::vector<int>> adyacentes; // Lista de adyacencia para representar las conexiones entre centros.
-        std::map<std::pair<int, int>, std::pair<int, bool>> minutosParaLlegar; // Mapa que almacena el tiempo de viaje y la disponibilidad entre dos centros.
-
-    public:
-        /**
-         * Constructor de la clase Rutas.
-         * 
-         * @param centroAgua Número total de centros de agua en la red.
-         */
-        Rutas(int centroAgua) {
-            this->centroAgua = centroAgua;
-            adyacentes = std::vector<std::vector<int>>(centroAgua);
-        }
-
-        /**
-         * Obtiene el número total de centros de agua en la red.
-         * 
-         * @return Número de centros de agua.
-         */
-        int getNumeroCentrosAgua() {
-            return centroAgua;
-        }
-
-        /**
-         * Obtiene la lista de centros de agua adyacentes a un centro dado.
-         * 
-         * @param numeroCentroAgua El índice del centro de agua.
-         * @return Vector de índices de centros adyacentes.
-         */
-        std::vector<int> getAdyacentes(int numeroCentroAgua) {
-            return adyacentes[numeroCentroAgua];
-        }
-
-        /**
-         * Obtiene el tiempo de viaje y la disponibilidad de la tubería entre dos centros de agua.
-         * 
-         * @param u Índice del centro de agua de origen.
-         * @param v Índice del centro de agua de destino.
-         * @return Par conteniendo el tiempo de viaje y la disponibilidad de la tubería.
-         */
-        std::pair<int, bool> getMinutosParaLlegarYDisponibilidad(int u, int v) {
-            return minutosParaLlegar[{u, v}];
-        }
-
-        /**
-         * Agrega o actualiza una tubería entre dos centros de agua.
-         * 
-         * @param u Índice del centro de agua de origen.
-         * @param v Índice del centro de agua de destino.
-         * @param peso Tiempo de viaje a través de la tubería.
-         * @param disponibilidad Estado de disponibilidad de la tubería.
-         */
-        void agregarTuberia(int u, int v, int tiempoParaLlegar, bool disponibilidad = true) {
-            adyacentes[u].push_back(v);
-            minutosParaLlegar[{u, v}] = {tiempoParaLlegar, disponibilidad}; 
-        }
-
-        /**
-         * Establece la disponibilidad de una tubería existente entre dos centros de agua.
-         * 
-         * @param u Índice del centro de agua de origen.
-         * @param v Índice del centro de agua de destino.
-         * @param disponibilidad Nuevo estado de disponibilidad para la tubería.
-         */
-        void establecerDisponibilidad(int u, int v, bool disponibilidad) {
-            if (minutosParaLlegar.find({u, v}) != minutosParaLlegar.end()) {
-                minutosParaLlegar[{u, v}].second = disponibilidad;
-                std::cout << "Tubería " << u << " a " << v << " modificada." << std::endl;
-            } else {
-                std::cout << "La tuberia de " << u << " a " << v << " no existe." << std::endl;
-            }
-        }
-
-};
-
-/**
- * Clase ColaPrioridad
- *
- * Esta clase implementa una cola de prioridad utilizando un multiset de la STL de C++. 
- * La cola de prioridad es esencial para el algoritmo de Dijkstra, ya que permite extraer 
- * el elemento con la menor prioridad (o costo, en este caso en el menor tiempo de llegada) de manera eficiente.
- */
-class ColaPrioridad {
-    private:
-        // Multiset para almacenar los elementos junto con sus prioridades
-        std::multiset<std::pair<int, int>> elementos;
-
-    public:
-        // Constructor de la clase ColaPrioridad
-        ColaPrioridad() {}
-
-        /**
-         * Inserta un elemento con una prioridad dada en la cola de prioridad.
-         * 
-         * @param elemento El elemento a insertar.
-         * @param prioridad La prioridad del elemento.
-         */
-        void insertar(int elemento, int prioridad) {
-            elementos.insert({prioridad, elemento});
-        }
-
-        /**
-         * Extrae el elemento con la menor prioridad de la cola de prioridad.
-         * 
-         * @return El elemento con la menor prioridad.
-         */
-        int extraerMinimo() {
-            int minimo = elementos.begin()->second; // Acceder al segundo elemento del par del primer elemento
-            elementos.erase(elementos.begin()); // Eliminar el primer elemento
-            return minimo;
-        }
-
-        /**
-         * Inserta un nuevo elemento o decrementa la prioridad de un elemento existente.
-         * 
-         * @param elemento El elemento a insertar o cuyo prioridad se debe decrementar.
-         * @param nuevaPrioridad La nueva prioridad del elemento.
-         */
-        void insertarODecrementar(int elemento, int nuevaPrioridad) {
-            for (auto it = elementos.begin(); it != elementos.end(); ++it) {
-                if (it->second == elemento) {
-                    elementos.erase(it);
-                    break;
-                }
-            }
-            elementos.insert({nuevaPrioridad, elemento});
-        }
-
-        /**
-         * Encuentra el índice de un elemento en la cola de prioridad.
-         * 
-         * @param elemento El elemento a encontrar.
-         * @return El índice del elemento, o -1 si no se encuentra.
-         */
-        int encontrarElemento(int elemento) {
-            for (auto it = elementos.begin(); it != elementos.end(); ++it) {
-                if (it->second == elemento) {
-                    return std::distance(elementos.begin(), it); // Índice
-                }
-            }
-            return -1;
-        }
-
-        /**
-         * Obtiene los elementos de la cola de prioridad.
-         * 
-         * @return El multiset de elementos y sus prioridades.
-         */
-        const std::multiset<std::pair<int, int>>& getElementos() {
-            return elementos;
-        }
-
-        /**
-         * Verifica si la cola de prioridad está vacía.
-         * 
-         * @return Verdadero si la cola está vacía, falso en caso contrario.
-         */
-        bool isEmpty() {
-            return elementos.empty();
-        }
-};
-
-
-/**
- * Implementación del algoritmo de Dijkstra para encontrar las rutas más cortas desde un centro de agua de origen
- * a todos los otros centros de agua en la red.
- * 
- * @param G Grafo que representa la red de tuberías de agua (instancia de la clase Rutas).
- * @param centroAguaOrigen Índice del centro de agua de origen desde el cual se calcularán las rutas más cortas.
- * @return Un par de vectores:
- *         - El primer vector contiene el tiempo acumulado mínimo para llegar a cada centro de agua desde el centro de agua de origen.
- *         - El segundo vector contiene el índice del centro de agua anterior para cada centro de agua en la ruta más corta.
- */
-std::pair<std::vector<int>, std::vector<int>> Dijkstra(Rutas G, int centroAguaOrigen) {
-    int numeroCentrosAgua = G.getNumeroCentrosAgua(); // Obtener el número total de centros de agua
-    std::vector<int> minutosParaLlegarAcumulados(numeroCentrosAgua, INT_MAX); // Vector para almacenar el tiempo acumulado mínimo para llegar a cada centro de agua
-    std::vector<int> centrosAguaPrevio(numeroCentrosAgua, -1); // Vector para almacenar el centro de agua previo en la ruta más corta
-    std::vector<bool> centroAguaVisitado(numeroCentrosAgua, false); // Vector para marcar los centros de agua visitados
-    ColaPrioridad colaPrioridad; // Cola de prioridad para gestionar los centros de agua según su tiempo acumulado mínimo
-
-    minutosParaLlegarAcumulados[centroAguaOrigen] = 0; // Establecer el tiempo acumulado del centro de agua de origen a 0
-    colaPrioridad.insertar(centroAguaOrigen, 0); // Insertar el centro de agua de origen en la cola de prioridad con un tiempo de llegada de 0
-
-    // Mientras la cola de prioridad no esté vacía
-    while (!colaPrioridad.isEmpty()) {
-        int centroAguaActual = colaPrioridad.extraerMinimo(); // Extraer el centro de agua con el menor tiempo acumulado
-        centroAguaVisitado[centroAguaActual] = true; // Marcar el centro de agua actual como visitado
-
-        // Para cada centro de agua vecino del centro de agua actual
-        for (int centroAguaVecino : G.getAdyacentes(centroAguaActual)) {
-            auto [minutosParaLlegar, disponibilidad] = G.getMinutosParaLlegarYDisponibilidad(centroAguaActual, centroAguaVecino); // Obtener el tiempo de viaje y la disponibilidad de la tubería entre los centros de agua
-            if (disponibilidad && !centroAguaVisitado[centroAguaVecino]) { // Si la tubería está disponible y el centro de agua vecino no ha sido visitado
-                int nuevosMinutosParaLlegar = minutosParaLlegarAcumulados[centroAguaActual] + minutosParaLlegar; // Calcular el nuevo tiempo acumulado para llegar al centro de agua vecino
-
-                // Si el nuevo tiempo acumulado es menor que el tiempo acumulado actual
-                if (nuevosMinutosParaLlegar < minutosParaLlegarAcumulados[centroAguaVecino]) {
-                    minutosParaLlegarAcumulados[centroAguaVecino] = nuevosMinutosParaLlegar; // Actualizar el tiempo acumulado mínimo
-                    centrosAguaPrevio[centroAguaVecino] = centroAguaActual; // Actualizar el centro de agua previo en la ruta más corta
-                    colaPrioridad.insertarODecrementar(centroAguaVecino, nuevosMinutosParaLlegar); // Insertar o actualizar la prioridad del centro de agua vecino en la cola de prioridad
-                }
-            }
-        }
-    }
-
-    // Retornar el vector de tiempos acumulados y el vector de centros de agua previos
-    return {minutosParaLlegarAcumulados, centrosAguaPrevio};
-}
-
-/**
- * Reconstruye la ruta más corta desde el centro de agua de origen hasta el centro de agua destino
- * utilizando el vector de centros de agua previos calculado por el algoritmo de Dijkstra.
- * 
- * @param centrosAguaPrevio Vector que contiene el índice del centro de agua anterior para cada centro de agua en la ruta más corta.
- * @param centroAguaDestino Índice del centro de agua destino al que se quiere llegar.
- * @return Un vector que contiene la secuencia de centros de agua desde el origen hasta el destino en la ruta más corta.
- */
-std::vector<int> reconstruirRuta(const std::vector<int>& centrosAguaPrevio, int centroAguaDestino) {
-    std::vector<int> rutaDestino; // Vector para almacenar la ruta desde el origen hasta el destino
-
-    // Recorre el vector de centros de agua previos desde el destino hasta el origen
-    for (int centroAguaActual = centroAguaDestino; centroAguaActual != -1; centroAguaActual = centrosAguaPrevio[centroAguaActual]) {
-        rutaDestino.push_back(centroAguaActual); // Agrega el centro de agua actual a la ruta
-    }
-
-    // Invierte el vector para obtener la ruta desde el origen hasta el destino
-    std::reverse(rutaDestino.begin(), rutaDestino.end());
-
-    return rutaDestino; // Retorna la ruta reconstruida
-}
+#include "rutas.h"
+#include "cola_prioridad.h"
+#include "dijkstra.h"
+#include "pool_hilos.h"
+#include "todos_origenes.h"
+#include "rutas_dinamicas.h"
+#include "consulta_ruta.h"
+#include "formato_binario.h"
+#include "importador.h"
+#include "modo_lotes.h"
+#include "exportar_red.h"
+#include "visualizador_python.h"
+#include "instrumentacion.h"
 
 void mostrarMenu() {
     std::cout << "Menu:" << std::endl;
@@ -256,32 +24,30 @@ void mostrarMenu() {
     std::cout << "4. Habilitar tubería." << std::endl; // Habilita una tubería existente entre dos centros de agua
     std::cout << "5. Ver rutas actuales y descargarlo." << std::endl; // Muestra las rutas actuales modificadas y las descarga a un archivo
     std::cout << "6. Calcular rutas optimas de cada centro de agua." << std::endl; // Calcula las rutas óptimas desde cada centro de agua a los demás
-    std::cout << "7. Salir" << std::endl; // Sale del programa
+    std::cout << "7. Consultar ruta entre dos centros de agua." << std::endl; // Calcula la ruta más corta entre un origen y un destino
+    std::cout << "8. Salir" << std::endl; // Sale del programa
     std::cout << "Ingrese una opcion: ";
 }
 
 
-/*Esta función nos permite interactuar con funciones dentro de un archivo .py
-  para ser llamados dentro de este entorno,
-  Funciona como un API de C++/Python*/
-  
-void callPythonFunction(PyObject* pModule, const std::string& funcName, PyObject* args) {
-    PyObject* pFunc = PyObject_GetAttrString(pModule, funcName.c_str());
-    if (pFunc && PyCallable_Check(pFunc)) {
-        PyObject* pValue = PyObject_CallObject(pFunc, args);
-        if (pValue != nullptr) {
-            const char* result = PyUnicode_AsUTF8(pValue);
-            std::cout << result << std::endl;
-            Py_DECREF(pValue);
-        } else {
-            PyErr_Print();
-            std::cerr << "Llamada a la función " << funcName << " fallida" << std::endl;
+/**
+ * Muestra el tiempo total actualizado desde cada origen seguido en modo dinámico, después de modificar una tubería.
+ * 
+ * @param rutasDinamicas Rutas dinámicas con los árboles de los orígenes seguidos.
+ */
+void mostrarRutasSeguidas(const RutasDinamicas& rutasDinamicas) {
+    for (const auto& [origen, arbol] : rutasDinamicas.getArboles()) {
+        long long minutosTotales = 0;
+        int centrosInalcanzables = 0;
+        for (int minutos : arbol.getMinutosParaLlegarAcumulados()) {
+            if (minutos == INT_MAX) {
+                centrosInalcanzables++;
+            } else {
+                minutosTotales += minutos;
+            }
         }
-        Py_DECREF(pFunc);
-    } else {
-        if (PyErr_Occurred())
-            PyErr_Print();
-        std::cerr << "No se pudo encontrar la función " << funcName << std::endl;
+        std::cout << "Rutas desde el origen " << origen << " reparadas (" << arbol.getNumeroAfectados() << " centros recalculados): "
+                  << minutosTotales << " minutos totales, " << centrosInalcanzables << " sin camino." << std::endl;
     }
 }
 
@@ -362,185 +128,297 @@ void clearScreen() {
     #endif
 }
 
-int main() {
-    // Inicializar el intérprete de Python
-    Py_Initialize();
+/**
+ * Crea la red inicial de ejemplo de la opción 1: 5 centros de agua y 10 tuberías.
+ * 
+ * @return Red creada; el llamador la libera.
+ */
+Rutas* crearRutasIniciales() {
+    int numeroCentrosAgua = 5; 
+    Rutas* rutas = new Rutas(numeroCentrosAgua);
+    rutas->agregarTuberia(0, 1, 10);
+    rutas->agregarTuberia(0, 3, 5);
+    rutas->agregarTuberia(1, 2, 1);
+    rutas->agregarTuberia(1, 3, 2);
+    rutas->agregarTuberia(2, 4, 4);
+    rutas->agregarTuberia(3, 1, 3);
+    rutas->agregarTuberia(3, 2, 9);
+    rutas->agregarTuberia(3, 4, 2);
+    rutas->agregarTuberia(4, 0, 7);
+    rutas->agregarTuberia(4, 2, 6);
+    return rutas;
+}
+
+/**
+ * Carga la red de un archivo: binario (.bin, ver convertir_red.cpp) o lista de tuberías en texto. El archivo binario
+ * se verifica completo y se copia a Rutas, que el menú y el modo por lotes modifican; para consultar una red binaria
+ * sin copiarla, EspacioDijkstra::ejecutar puede leer RedMapeada::getRed() directamente.
+ * 
+ * @param archivoRed Ruta del archivo.
+ * @param poolHilos Hilos para importar la lista de tuberías.
+ * @param mensajes Flujo donde se informan la carga y los problemas encontrados.
+ * @return Red cargada (el llamador la libera), o nullptr si no se pudo cargar.
+ */
+Rutas* cargarRutas(const std::string& archivoRed, PoolHilos& poolHilos, std::ostream& mensajes) {
+    Rutas* rutas = nullptr;
+    RedMapeada redMapeada;
+    RedCSR redImportada;
+    InformeImportacion informe;
+    ImportadorTuberias importador(poolHilos);
+    bool esBinaria = archivoRed.size() >= 4 && archivoRed.compare(archivoRed.size() - 4, 4, ".bin") == 0;
+    if (esBinaria && redMapeada.abrir(archivoRed) && redMapeada.verificar()) {
+        rutas = new Rutas(redMapeada.copiarRedCSR());
+    } else if (esBinaria) {
+        mensajes << redMapeada.getError() << std::endl;
+    } else if (importador.importar(archivoRed, 0, redImportada, informe)) {
+        rutas = new Rutas(std::move(redImportada));
+        mensajes << "Importadas " << informe.tuberias << " tuberias a " << informe.megabytesPorSegundo << " MB/s." << std::endl;
+    }
+    for (const std::string& problema : informe.problemas) {
+        mensajes << problema << std::endl;
+    }
+    if (rutas != nullptr) {
+        mensajes << "Rutas cargadas de " << archivoRed << " con " << rutas->getNumeroCentrosAgua() << " centros de agua." << std::endl;
+    }
+    return rutas;
+}
+
+/**
+ * Modo por lotes (ver modo_lotes.h): lee comandos de la entrada estándar y responde una línea por comando en la
+ * salida estándar; los mensajes de carga van a la salida de errores para no mezclarse con las respuestas.
+ * No usa Python ni espera teclas.
+ * 
+ * @param archivoRed Archivo de red opcional; si está vacío se usa la red inicial de ejemplo.
+ * @return Código de salida del programa.
+ */
+int ejecutarModoLotes(const std::string& archivoRed) {
+    std::ios::sync_with_stdio(false); // Entrada y salida con búfer propio: necesario para saber si quedan comandos esperando
+    std::cin.tie(nullptr);
+    PoolHilos poolHilos;
+    Rutas* rutas = archivoRed.empty() ? crearRutasIniciales() : cargarRutas(archivoRed, poolHilos, std::cerr);
+    if (rutas == nullptr) {
+        return 1;
+    }
+    ProcesadorLotes procesador(*rutas, poolHilos);
+    procesador.procesar(std::cin, std::cout);
+    delete rutas;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    // Con --lotes el programa lee comandos de la entrada estándar en lugar de mostrar el menú
+    if (argc > 1 && std::string(argv[1]) == "--lotes") {
+        return ejecutarModoLotes(argc > 2 ? argv[2] : "");
+    }
 
-    // Cargar el script de Python
-    PyObject* pName = PyUnicode_DecodeFSDefault("graph_script");
-    PyObject* pModule = PyImport_Import(pName);
-    Py_DECREF(pName);
+    // Archivo de red opcional para la opción 1: binario (.bin, ver convertir_red.cpp) o lista de tuberías en texto
+    std::string archivoRed = argc > 1 ? argv[1] : "";
 
     Rutas* rutasActuales = nullptr;
+    RutasDinamicas* rutasDinamicas = nullptr; // Mantiene al día las rutas del origen óptimo al modificar tuberías
+    PoolHilos poolHilos; // Hilos para el cálculo de rutas desde todos los orígenes
+    VisualizadorPython visualizador; // Dibujo en Python en su propio hilo; no bloquea el menú
     int opcion;
 
-    if (pModule != nullptr) {
-        while (true) {
-            clearScreen();
-            mostrarMenu();
-            std::cin >> opcion;
-
-            switch (opcion) {
-                case 1: {
-                    if (rutasActuales == nullptr) {
-                        int numeroCentrosAgua = 5; 
-                        rutasActuales = new Rutas(numeroCentrosAgua);
-                        rutasActuales->agregarTuberia(0, 1, 10);
-                        rutasActuales->agregarTuberia(0, 3, 5);
-                        rutasActuales->agregarTuberia(1, 2, 1);
-                        rutasActuales->agregarTuberia(1, 3, 2);
-                        rutasActuales->agregarTuberia(2, 4, 4);
-                        rutasActuales->agregarTuberia(3, 1, 3);
-                        rutasActuales->agregarTuberia(3, 2, 9);
-                        rutasActuales->agregarTuberia(3, 4, 2);
-                        rutasActuales->agregarTuberia(4, 0, 7);
-                        rutasActuales->agregarTuberia(4, 2, 6);
-                        std::cout << "Rutas inicializadas con " << numeroCentrosAgua << " centros de agua." << std::endl;
-
-                        // Llamado de la función inicializar_grafo en Python
-                        callPythonFunction(pModule, "inicializar_rutas", nullptr);
-                    } else {
-                        std::cout << "Las rutas ya han sido inicializadas." << std::endl;
+    while (true) {
+        clearScreen();
+        mostrarMenu();
+        std::cin >> opcion;
+
+        switch (opcion) {
+            case 1: {
+                if (rutasActuales == nullptr && !archivoRed.empty()) {
+                    rutasActuales = cargarRutas(archivoRed, poolHilos, std::cout);
+                    if (rutasActuales != nullptr) {
+                        rutasDinamicas = new RutasDinamicas(*rutasActuales);
                     }
-                    std::cout << "Presione una tecla para continuar" << std::endl;
-                    std::cin.ignore();
-                    std::cin.get();
-                    break;
+                } else if (rutasActuales == nullptr) {
+                    rutasActuales = crearRutasIniciales();
+                    rutasDinamicas = new RutasDinamicas(*rutasActuales);
+                    std::cout << "Rutas inicializadas con " << rutasActuales->getNumeroCentrosAgua() << " centros de agua." << std::endl;
+
+                    // Dibujo del mapa inicial en Python (asíncrono)
+                    visualizador.inicializarRutas();
+                } else {
+                    std::cout << "Las rutas ya han sido inicializadas." << std::endl;
                 }
-                case 2: {
-                    if (rutasActuales == nullptr) {
-                        std::cout << "Primero inicialice las rutas." << std::endl;
+                std::cout << "Presione una tecla para continuar" << std::endl;
+                std::cin.ignore();
+                std::cin.get();
+                break;
+            }
+            case 2: {
+                if (rutasActuales == nullptr) {
+                    std::cout << "Primero inicialice las rutas." << std::endl;
+                } else {
+                    int u, v, peso;
+                    std::cout << "Ingrese el centro de agua origen: ";
+                    llenarNumeroInt(u);
+                    std::cout << "Ingrese el centro de agua destino: ";
+                    llenarNumeroInt(v);
+                    std::cout << "Ingrese los minutos que tarda en llegar de un punto a otro: ";
+                    llenarNumeroInt(peso);
+                    int numeroCentrosAgua = rutasActuales->getNumeroCentrosAgua();
+                    if (u < 0 || u >= numeroCentrosAgua || v < 0 || v >= numeroCentrosAgua) {
+                        std::cout << "Los centros de agua deben estar entre 0 y " << numeroCentrosAgua - 1 << "." << std::endl;
                     } else {
-                        int u, v, peso;
-                        std::cout << "Ingrese el centro de agua origen: ";
-                        llenarNumeroInt(u);
-                        std::cout << "Ingrese el centro de agua destino: ";
-                        llenarNumeroInt(v);
-                        std::cout << "Ingrese los minutos que tarda en llegar de un punto a otro: ";
-                        llenarNumeroInt(peso);
-                        rutasActuales->agregarTuberia(u, v, peso);
-                        callPythonFunction(pModule, "agregar_tuberia", PyTuple_Pack(3, PyLong_FromLong(u), PyLong_FromLong(v), PyLong_FromLong(peso)));
+                        rutasDinamicas->agregarTuberia(u, v, peso);
+                        visualizador.agregarTuberia(u, v, peso);
                         std::cout << "TUbería agregada de " << u << " a " << v << " con minutos entre los centros de " << peso << "." << std::endl;
                     }
-                    std::cout << "Presione una tecla para continuar" << std::endl;
-                    std::cin.ignore();
-                    std::cin.get();
-                    break;
                 }
-                case 3: {
-                    if (rutasActuales == nullptr) {
-                        std::cout << "Primero inicialice las rutas." << std::endl;
-                    } else {
-                        int u, v;
-                        std::cout << "Ingrese el centro de agua origen: ";
-                        llenarNumeroInt(u);
-                        std::cout << "Ingrese el centro de agua destino: ";
-                        llenarNumeroInt(v);
-                        rutasActuales->establecerDisponibilidad(u, v, false);
-                        callPythonFunction(pModule, "establecer_no_disponibilidad", PyTuple_Pack(2, PyLong_FromLong(u), PyLong_FromLong(v)));
+                std::cout << "Presione una tecla para continuar" << std::endl;
+                std::cin.ignore();
+                std::cin.get();
+                break;
+            }
+            case 3: {
+                if (rutasActuales == nullptr) {
+                    std::cout << "Primero inicialice las rutas." << std::endl;
+                } else {
+                    int u, v;
+                    std::cout << "Ingrese el centro de agua origen: ";
+                    llenarNumeroInt(u);
+                    std::cout << "Ingrese el centro de agua destino: ";
+                    llenarNumeroInt(v);
+                    int numeroCentrosAgua = rutasActuales->getNumeroCentrosAgua();
+                    if (u < 0 || u >= numeroCentrosAgua || v < 0 || v >= numeroCentrosAgua) {
+                        std::cout << "Los centros de agua deben estar entre 0 y " << numeroCentrosAgua - 1 << "." << std::endl;
+                    } else if (rutasDinamicas->establecerDisponibilidad(u, v, false)) {
+                        mostrarRutasSeguidas(*rutasDinamicas);
+                        visualizador.establecerDisponibilidad(u, v, false);
                     }
-                    std::cout << "Presione una tecla para continuar" << std::endl;
-                    std::cin.ignore();
-                    std::cin.get();
-                    break;
                 }
-                case 4:{
-                    if (rutasActuales == nullptr) {
-                        std::cout << "Primero inicialice las rutas." << std::endl;
-                    } else {
-                        int u, v;
-                        std::cout << "Ingrese el centro de agua origen: ";
-                        llenarNumeroInt(u);
-                        std::cout << "Ingrese el centro de agua destino: ";
-                        llenarNumeroInt(v);
-                        rutasActuales->establecerDisponibilidad(u, v, true);
-                        callPythonFunction(pModule, "establecer_disponibilidad", PyTuple_Pack(2, PyLong_FromLong(u), PyLong_FromLong(v)));
+                std::cout << "Presione una tecla para continuar" << std::endl;
+                std::cin.ignore();
+                std::cin.get();
+                break;
+            }
+            case 4:{
+                if (rutasActuales == nullptr) {
+                    std::cout << "Primero inicialice las rutas." << std::endl;
+                } else {
+                    int u, v;
+                    std::cout << "Ingrese el centro de agua origen: ";
+                    llenarNumeroInt(u);
+                    std::cout << "Ingrese el centro de agua destino: ";
+                    llenarNumeroInt(v);
+                    int numeroCentrosAgua = rutasActuales->getNumeroCentrosAgua();
+                    if (u < 0 || u >= numeroCentrosAgua || v < 0 || v >= numeroCentrosAgua) {
+                        std::cout << "Los centros de agua deben estar entre 0 y " << numeroCentrosAgua - 1 << "." << std::endl;
+                    } else if (rutasDinamicas->establecerDisponibilidad(u, v, true)) {
+                        mostrarRutasSeguidas(*rutasDinamicas);
+                        visualizador.establecerDisponibilidad(u, v, true);
                     }
-                    std::cout << "Presione una tecla para continuar" << std::endl;
-                    std::cin.ignore();
-                    std::cin.get();
-                    break;
                 }
-                case 5: {
-                    if (rutasActuales == nullptr) {
-                        std::cout << "Primero inicialice las rutas." << std::endl;
-                    } else{
-                        callPythonFunction(pModule, "mostrar_rutas", nullptr);
+                std::cout << "Presione una tecla para continuar" << std::endl;
+                std::cin.ignore();
+                std::cin.get();
+                break;
+            }
+            case 5: {
+                if (rutasActuales == nullptr) {
+                    std::cout << "Primero inicialice las rutas." << std::endl;
+                } else{
+                    // Exportación nativa, inmediata aunque Python no esté disponible
+                    const RedCSR& red = rutasActuales->getRedCSR();
+                    for (const char* archivo : {"mapa_actual.dot", "mapa_actual.graphml"}) {
+                        if (exportarRed(red, archivo)) {
+                            std::cout << "Red exportada a " << archivo << "." << std::endl;
+                        } else {
+                            std::cout << "No se pudo escribir " << archivo << "." << std::endl;
+                        }
                     }
-                    std::cout << "Presione una tecla para continuar" << std::endl;
-                    std::cin.ignore();
-                    std::cin.get();
-                    break;
+                    visualizador.mostrarRutas();
                 }
-                case 6: {
-                    if (rutasActuales == nullptr) {
-                        std::cout << "Primero inicialice las rutas." << std::endl;
-                    } else {
-                        /*Esta opción nos permite hacer el benchmarking de acuerdo a los centros de agua actuales
-                          y su tiempo óptimo en llegar a los demas centros de agua, en minutos. Esto nos permite
-                          comparar cual centro de agua es factible comenzar a abastecer agua, para que llegue a los
-                          demás centros y no dejar de abastecer aguar a las zonas aledañas. */
-                        int origenOptimoIndex = -1;
-                        int tiempoMenor = INT_MAX;
-                        int V = rutasActuales->getNumeroCentrosAgua();
-                        for (int centrodeAguaOrigen = 0; centrodeAguaOrigen < V; ++centrodeAguaOrigen) {
-                            int minutosAcumuladosTotales = 0;
-                            std::pair<std::vector<int>, std::vector<int>> resultado = Dijkstra(*rutasActuales, centrodeAguaOrigen);
-                            std::vector<int> distancias = resultado.first;
-
-                            std::cout << "Distancias desde el pozo/centro de agua " << centrodeAguaOrigen << ":" << std::endl;
-                            for (int destino = 0; destino < V; ++destino) {
-                                if (distancias[destino] == INT_MAX) {
-                                    std::cout << "No hay camino a " << destino << std::endl;
-                                } else {
-                                    std::cout << "Distancia a pozo/centro de agua " << destino << ": " << distancias[destino] << std::endl;
-                                }
-                                minutosAcumuladosTotales += distancias[destino];
-                            }
+                std::cout << "Presione una tecla para continuar" << std::endl;
+                std::cin.ignore();
+                std::cin.get();
+                break;
+            }
+            case 6: {
+                if (rutasActuales == nullptr) {
+                    std::cout << "Primero inicialice las rutas." << std::endl;
+                } else {
+                    /*Esta opción nos permite hacer el benchmarking de acuerdo a los centros de agua actuales
+                      y su tiempo óptimo en llegar a los demas centros de agua, en minutos. Esto nos permite
+                      comparar cual centro de agua es factible comenzar a abastecer agua, para que llegue a los
+                      demás centros y no dejar de abastecer aguar a las zonas aledañas. */
+                    ResultadoTodosOrigenes resultado = calcularTodosOrigenes(*rutasActuales, poolHilos);
+                    int origenOptimoIndex = resultado.origenOptimo;
+                    int V = rutasActuales->getNumeroCentrosAgua();
+                    for (int centrodeAguaOrigen = 0; centrodeAguaOrigen < V; ++centrodeAguaOrigen) {
+                        const ResumenOrigen& resumen = resultado.resumenes[centrodeAguaOrigen];
+                        std::cout << "Distancia total desde el pozo/centro de agua " << centrodeAguaOrigen << ": " << resumen.minutosTotales
+                                  << " (maxima " << resumen.minutosMaximo << ", sin camino " << resumen.centrosInalcanzables << ")" << std::endl;
+                    }
+                    std::cout << std::endl;
+
+                    rutasDinamicas->seguirOrigen(origenOptimoIndex, resultado.minutosOrigenOptimo, resultado.previoOrigenOptimo);
+                    const std::vector<int>& distancias = resultado.minutosOrigenOptimo;
+                    std::cout << "Origen optimo: " << origenOptimoIndex << std::endl;
+                    for (int destino = 0; destino < V; ++destino) {
+                        if (distancias[destino] == INT_MAX) {
+                            std::cout << "No hay camino a " << destino << std::endl;
+                        } else {
+                            std::cout << "Distancia a pozo/centro de agua " << destino << ": " << distancias[destino] << std::endl;
+                        }
+                    }
+                    if (instrumentacionActiva) {
+                        std::cout << std::endl << "Instrumentacion:" << std::endl;
+                        volcarInstrumentacion(std::cout);
+                        std::cout << std::endl;
+                    }
 
-                            if(tiempoMenor > minutosAcumuladosTotales){
-                                tiempoMenor = minutosAcumuladosTotales;
-                                origenOptimoIndex = centrodeAguaOrigen;
+                }
+                std::cout << "Presione una tecla para continuar" << std::endl;
+                std::cin.ignore();
+                std::cin.get();
+                break;
+            }
+            case 7: {
+                if (rutasActuales == nullptr) {
+                    std::cout << "Primero inicialice las rutas." << std::endl;
+                } else {
+                    int u, v;
+                    std::cout << "Ingrese el centro de agua origen: ";
+                    llenarNumeroInt(u);
+                    std::cout << "Ingrese el centro de agua destino: ";
+                    llenarNumeroInt(v);
+                    int numeroCentrosAgua = rutasActuales->getNumeroCentrosAgua();
+                    if (u < 0 || u >= numeroCentrosAgua || v < 0 || v >= numeroCentrosAgua) {
+                        std::cout << "Los centros de agua deben estar entre 0 y " << numeroCentrosAgua - 1 << "." << std::endl;
+                    } else {
+                        ConsultaRuta consultaRuta(*rutasActuales);
+                        RutaConsultada ruta = consultaRuta.ruta(u, v, true);
+                        if (ruta.minutos == INT_MAX) {
+                            std::cout << "No hay camino de " << u << " a " << v << "." << std::endl;
+                        } else {
+                            std::cout << "Ruta de " << u << " a " << v << " (" << ruta.minutos << " minutos):";
+                            for (int centro : ruta.centros) {
+                                std::cout << " " << centro;
                             }
-
-                            std::cout << "Distancia total desde el pozo/centro de agua " << centrodeAguaOrigen << ": " << minutosAcumuladosTotales << std::endl;
                             std::cout << std::endl;
                         }
-
-                        std::pair<std::vector<int>, std::vector<int>> resultado = Dijkstra(*rutasActuales, origenOptimoIndex);
-                        std::vector<int> distancias = resultado.first;
-                        std::vector<int> previo = resultado.second;
-
-                        std::cout << "Origen optimo: " << origenOptimoIndex << std::endl;
-
                     }
-                    std::cout << "Presione una tecla para continuar" << std::endl;
-                    std::cin.ignore();
-                    std::cin.get();
-                    break;
-                }
-                case 7: {
-                    delete rutasActuales; // Liberar la memoria del grafo al final
-                    Py_DECREF(pModule);
-                    Py_Finalize();
-                    return 0;
-                }
-                default: {
-                    std::cout << "Opcion invalida. Intente de nuevo." << std::endl;
-                    std::cin.ignore();
-                    std::cin.get();
-                    break;
                 }
+                std::cout << "Presione una tecla para continuar" << std::endl;
+                std::cin.ignore();
+                std::cin.get();
+                break;
+            }
+            case 8: {
+                delete rutasDinamicas;
+                delete rutasActuales; // Liberar la memoria del grafo al final
+                return 0;
+            }
+            default: {
+                std::cout << "Opcion invalida. Intente de nuevo." << std::endl;
+                std::cin.ignore();
+                std::cin.get();
+                break;
             }
         }
-    } else {
-        PyErr_Print();
-        std::cerr << "No se pudo cargar el módulo graph_script" << std::endl;
-        std::cin.ignore();
-        std::cin.get();
     }
-
-    // Finalizar el intérprete de Python
-    Py_Finalize();
     return 0;
 }
@@ -0,0 +1,110 @@
+#ifndef EXPORTAR_RED_H
+#define EXPORTAR_RED_H
+
+#include <fstream>
+#include <string>
+#include "rutas.h"
+
+/*Exportación nativa de la red para visualizarla fuera del programa (Graphviz, Gephi, yEd, networkx.read_graphml...).
+  Reemplaza el dibujo en Python como camino principal: escribir el archivo es lineal en el número de tuberías y no
+  necesita el intérprete. Las tuberías deshabilitadas se marcan en rojo y punteadas, como en graph_script.py. */
+
+/**
+ * Escribe la red en formato DOT de Graphviz (por ejemplo: dot -Tpng mapa_actual.dot -o mapa_actual.png).
+ *
+ * @param red Instantánea CSR de la red.
+ * @param rutaArchivo Ruta del archivo a escribir.
+ * @return false si el archivo no se pudo escribir.
+ */
+bool exportarDOT(const RedCSR& red, const std::string& rutaArchivo) {
+    std::ofstream archivo(rutaArchivo);
+    if (!archivo) {
+        return false;
+    }
+    int numeroCentrosAgua = static_cast<int>(red.inicioAdyacentes.size()) - 1;
+    std::string bloque; // Las líneas se acumulan y se escriben en bloques para no pagar una escritura por tubería
+    bloque.reserve(1 << 16);
+    bloque += "digraph red_tuberias {\n  node [shape=circle, style=filled, fillcolor=skyblue];\n";
+    for (int centro = 0; centro < numeroCentrosAgua; ++centro) {
+        bloque += "  " + std::to_string(centro) + ";\n";
+        if (bloque.size() > (1 << 16) - 128) {
+            archivo << bloque;
+            bloque.clear();
+        }
+    }
+    for (int u = 0; u < numeroCentrosAgua; ++u) {
+        for (int tuberia = red.inicioAdyacentes[u]; tuberia < red.inicioAdyacentes[u + 1]; ++tuberia) {
+            bloque += "  " + std::to_string(u) + " -> " + std::to_string(red.destinos[tuberia]) +
+                      " [label=" + std::to_string(red.minutos[tuberia]) +
+                      (red.disponibles[tuberia] ? ", color=blue];\n" : ", color=red, style=dashed];\n");
+            if (bloque.size() > (1 << 16) - 128) {
+                archivo << bloque;
+                bloque.clear();
+            }
+        }
+    }
+    bloque += "}\n";
+    archivo << bloque;
+    return static_cast<bool>(archivo);
+}
+
+/**
+ * Escribe la red en formato GraphML, con los minutos y la disponibilidad de cada tubería como atributos.
+ *
+ * @param red Instantánea CSR de la red.
+ * @param rutaArchivo Ruta del archivo a escribir.
+ * @return false si el archivo no se pudo escribir.
+ */
+bool exportarGraphML(const RedCSR& red, const std::string& rutaArchivo) {
+    std::ofstream archivo(rutaArchivo);
+    if (!archivo) {
+        return false;
+    }
+    int numeroCentrosAgua = static_cast<int>(red.inicioAdyacentes.size()) - 1;
+    std::string bloque;
+    bloque.reserve(1 << 16);
+    bloque += "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+              "<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\">\n"
+              "  <key id=\"minutos\" for=\"edge\" attr.name=\"weight\" attr.type=\"int\"/>\n"
+              "  <key id=\"disponible\" for=\"edge\" attr.name=\"is_available\" attr.type=\"boolean\"/>\n"
+              "  <graph id=\"red_tuberias\" edgedefault=\"directed\">\n";
+    for (int centro = 0; centro < numeroCentrosAgua; ++centro) {
+        bloque += "    <node id=\"" + std::to_string(centro) + "\"/>\n";
+        if (bloque.size() > (1 << 16) - 256) {
+            archivo << bloque;
+            bloque.clear();
+        }
+    }
+    for (int u = 0; u < numeroCentrosAgua; ++u) {
+        for (int tuberia = red.inicioAdyacentes[u]; tuberia < red.inicioAdyacentes[u + 1]; ++tuberia) {
+            bloque += "    <edge source=\"" + std::to_string(u) + "\" target=\"" + std::to_string(red.destinos[tuberia]) +
+                      "\"><data key=\"minutos\">" + std::to_string(red.minutos[tuberia]) +
+                      "</data><data key=\"disponible\">" + (red.disponibles[tuberia] ? "true" : "false") + "</data></edge>\n";
+            if (bloque.size() > (1 << 16) - 256) {
+                archivo << bloque;
+                bloque.clear();
+            }
+        }
+    }
+    bloque += "  </graph>\n</graphml>\n";
+    archivo << bloque;
+    return static_cast<bool>(archivo);
+}
+
+/**
+ * Exporta la red eligiendo el formato por la extensión del archivo: .graphml para GraphML, cualquier otra para DOT.
+ *
+ * @param red Instantánea CSR de la red.
+ * @param rutaArchivo Ruta del archivo a escribir.
+ * @return false si el archivo no se pudo escribir.
+ */
+bool exportarRed(const RedCSR& red, const std::string& rutaArchivo) {
+    const std::string extension = ".graphml";
+    if (rutaArchivo.size() >= extension.size() &&
+        rutaArchivo.compare(rutaArchivo.size() - extension.size(), extension.size(), extension) == 0) {
+        return exportarGraphML(red, rutaArchivo);
+    }
+    return exportarDOT(red, rutaArchivo);
+}
+
+#endif // EXPORTAR_RED_H
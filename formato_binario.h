@@ -0,0 +1,384 @@
+#ifndef FORMATO_BINARIO_H
+#define FORMATO_BINARIO_H
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include "rutas.h"
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+/*Formato binario de la red de tuberías (versión 1). Todos los enteros se guardan en el orden de bytes de la
+  máquina que escribe el archivo (marcaOrden permite detectar un archivo de otra arquitectura) y cada sección
+  empieza en un múltiplo de 8 bytes:
+    - CabeceraRedBinaria
+    - inicioAdyacentes: int32 x (numeroCentrosAgua + 1)
+    - destinos:         int32 x numeroTuberias
+    - minutos:          int32 x numeroTuberias
+    - disponibles:      uint64 x ceil(numeroTuberias / 64), un bit por tubería
+  Es la misma disposición que RedCSR, así que EspacioDijkstra::ejecutar consulta el archivo directamente desde memoria
+  mapeada a través de RedCSRMapeada, sin copiarlo. Rutas necesita arreglos propios porque puede modificarse: para
+  armarla, copiarRedCSR copia cada sección de una vez (una reserva por arreglo, no por tubería). */
+
+const char FIRMA_RED_BINARIA[8] = {'P', 'C', 'T', 'F', 'R', 'E', 'D', '\0'};
+const uint32_t VERSION_RED_BINARIA = 1;
+const uint32_t MARCA_ORDEN_BYTES = 0x01020304;
+
+/**
+ * Estructura CabeceraRedBinaria
+ *
+ * Cabecera al inicio del archivo binario con la firma, la versión, los tamaños y la posición de cada sección.
+ */
+struct CabeceraRedBinaria {
+    char firma[8]; // FIRMA_RED_BINARIA
+    uint32_t version; // VERSION_RED_BINARIA
+    uint32_t marcaOrden; // MARCA_ORDEN_BYTES tal como la escribió la máquina de origen
+    uint32_t numeroCentrosAgua; // Número de centros de agua
+    uint32_t reservado; // Relleno, siempre 0
+    uint64_t numeroTuberias; // Número de tuberías
+    uint64_t desplazamientoInicios; // Posición de inicioAdyacentes en el archivo
+    uint64_t desplazamientoDestinos; // Posición de destinos en el archivo
+    uint64_t desplazamientoMinutos; // Posición de minutos en el archivo
+    uint64_t desplazamientoDisponibles; // Posición del conjunto de bits de disponibilidad
+    uint64_t tamanoArchivo; // Tamaño total esperado del archivo
+};
+
+/**
+ * Redondea una posición del archivo al siguiente múltiplo de 8 bytes.
+ */
+uint64_t alinearA8(uint64_t posicion) {
+    return (posicion + 7) & ~static_cast<uint64_t>(7);
+}
+
+/**
+ * Calcula la cabecera (tamaños y posiciones de cada sección) para una red del tamaño dado.
+ */
+CabeceraRedBinaria calcularCabeceraRedBinaria(uint32_t numeroCentrosAgua, uint64_t numeroTuberias) {
+    CabeceraRedBinaria cabecera;
+    std::memset(&cabecera, 0, sizeof(cabecera));
+    std::memcpy(cabecera.firma, FIRMA_RED_BINARIA, sizeof(cabecera.firma));
+    cabecera.version = VERSION_RED_BINARIA;
+    cabecera.marcaOrden = MARCA_ORDEN_BYTES;
+    cabecera.numeroCentrosAgua = numeroCentrosAgua;
+    cabecera.numeroTuberias = numeroTuberias;
+    cabecera.desplazamientoInicios = alinearA8(sizeof(CabeceraRedBinaria));
+    cabecera.desplazamientoDestinos = alinearA8(cabecera.desplazamientoInicios + (numeroCentrosAgua + 1ULL) * sizeof(int32_t));
+    cabecera.desplazamientoMinutos = alinearA8(cabecera.desplazamientoDestinos + numeroTuberias * sizeof(int32_t));
+    cabecera.desplazamientoDisponibles = alinearA8(cabecera.desplazamientoMinutos + numeroTuberias * sizeof(int32_t));
+    cabecera.tamanoArchivo = cabecera.desplazamientoDisponibles + (numeroTuberias + 63) / 64 * sizeof(uint64_t);
+    return cabecera;
+}
+
+/**
+ * Guarda una instantánea CSR en el formato binario.
+ *
+ * @param red Instantánea compacta de la red.
+ * @param rutaArchivo Ruta del archivo a escribir.
+ * @return true si el archivo se escribió completo, false en caso contrario.
+ */
+bool guardarRedBinaria(const RedCSR& red, const std::string& rutaArchivo) {
+    uint32_t numeroCentrosAgua = static_cast<uint32_t>(red.inicioAdyacentes.size() - 1);
+    uint64_t numeroTuberias = red.destinos.size();
+    CabeceraRedBinaria cabecera = calcularCabeceraRedBinaria(numeroCentrosAgua, numeroTuberias);
+
+    std::vector<uint64_t> bitsDisponibles((numeroTuberias + 63) / 64, 0);
+    for (uint64_t tuberia = 0; tuberia < numeroTuberias; ++tuberia) {
+        if (red.disponibles[tuberia]) {
+            bitsDisponibles[tuberia >> 6] |= 1ULL << (tuberia & 63);
+        }
+    }
+
+    std::ofstream archivo(rutaArchivo, std::ios::binary | std::ios::trunc);
+    if (!archivo) {
+        return false;
+    }
+    const char relleno[8] = {0};
+    auto escribirSeccion = [&](uint64_t desplazamiento, const void* datos, uint64_t bytes) {
+        uint64_t posicionActual = static_cast<uint64_t>(archivo.tellp());
+        archivo.write(relleno, static_cast<std::streamsize>(desplazamiento - posicionActual));
+        archivo.write(static_cast<const char*>(datos), static_cast<std::streamsize>(bytes));
+    };
+    archivo.write(reinterpret_cast<const char*>(&cabecera), sizeof(cabecera));
+    escribirSeccion(cabecera.desplazamientoInicios, red.inicioAdyacentes.data(), red.inicioAdyacentes.size() * sizeof(int32_t));
+    escribirSeccion(cabecera.desplazamientoDestinos, red.destinos.data(), numeroTuberias * sizeof(int32_t));
+    escribirSeccion(cabecera.desplazamientoMinutos, red.minutos.data(), numeroTuberias * sizeof(int32_t));
+    escribirSeccion(cabecera.desplazamientoDisponibles, bitsDisponibles.data(), bitsDisponibles.size() * sizeof(uint64_t));
+    return static_cast<bool>(archivo);
+}
+
+/**
+ * Guarda la red de Rutas en el formato binario.
+ *
+ * @param G Red de tuberías de agua.
+ * @param rutaArchivo Ruta del archivo a escribir.
+ * @return true si el archivo se escribió completo, false en caso contrario.
+ */
+bool guardarRedBinaria(Rutas& G, const std::string& rutaArchivo) {
+    return guardarRedBinaria(G.getRedCSR(), rutaArchivo);
+}
+
+/**
+ * Estructura VistaDisponibilidad
+ *
+ * Lectura del conjunto de bits de disponibilidad con la misma sintaxis que RedCSR::disponibles.
+ */
+struct VistaDisponibilidad {
+    const uint64_t* palabras = nullptr;
+
+    bool operator[](size_t tuberia) const {
+        return (palabras[tuberia >> 6] >> (tuberia & 63)) & 1;
+    }
+};
+
+/**
+ * Estructura RedCSRMapeada
+ *
+ * Vista de solo lectura de una red en memoria mapeada. Tiene los mismos arreglos que RedCSR, de modo que
+ * EspacioDijkstra::ejecutar funciona sobre ella sin copiar nada.
+ */
+struct RedCSRMapeada {
+    const int32_t* inicioAdyacentes = nullptr; // Desplazamiento de la primera tubería de cada centro
+    const int32_t* destinos = nullptr; // Centro de agua destino de cada tubería
+    const int32_t* minutos = nullptr; // Tiempo de viaje de cada tubería
+    VistaDisponibilidad disponibles; // Disponibilidad de cada tubería
+    int numeroCentrosAgua = 0; // Número de centros de agua
+    long long numeroTuberias = 0; // Número de tuberías
+};
+
+/**
+ * Clase RedMapeada
+ *
+ * Abre un archivo de red binario con mmap (MapViewOfFile en Windows). Abrir el archivo solo valida la cabecera,
+ * así una red con millones de tuberías queda lista para consultar con getRed() sin leerla ni reservar memoria por
+ * tubería; el sistema operativo carga las páginas a medida que las búsquedas las tocan. Un archivo que no se escribió
+ * con guardarRedBinaria debe pasar antes por verificar(), que sí lo recorre completo.
+ */
+class RedMapeada {
+    private:
+        const char* datos = nullptr; // Inicio del archivo mapeado
+        uint64_t tamano = 0; // Tamaño del archivo mapeado
+        RedCSRMapeada red; // Vista sobre las secciones del archivo
+        std::string error; // Descripción del último error
+#ifdef _WIN32
+        HANDLE archivo = INVALID_HANDLE_VALUE;
+        HANDLE mapeo = nullptr;
+#endif
+
+        /**
+         * Libera el mapeo actual, si existe.
+         */
+        void cerrar() {
+#ifdef _WIN32
+            if (datos != nullptr) {
+                UnmapViewOfFile(datos);
+            }
+            if (mapeo != nullptr) {
+                CloseHandle(mapeo);
+            }
+            if (archivo != INVALID_HANDLE_VALUE) {
+                CloseHandle(archivo);
+            }
+            mapeo = nullptr;
+            archivo = INVALID_HANDLE_VALUE;
+#else
+            if (datos != nullptr) {
+                munmap(const_cast<char*>(datos), tamano);
+            }
+#endif
+            datos = nullptr;
+            tamano = 0;
+            red = RedCSRMapeada();
+        }
+
+        /**
+         * Mapea el archivo completo en memoria de solo lectura.
+         */
+        bool mapear(const std::string& rutaArchivo) {
+#ifdef _WIN32
+            archivo = CreateFileA(rutaArchivo.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (archivo == INVALID_HANDLE_VALUE) {
+                error = "No se pudo abrir el archivo " + rutaArchivo;
+                return false;
+            }
+            LARGE_INTEGER tamanoArchivo;
+            if (!GetFileSizeEx(archivo, &tamanoArchivo) || tamanoArchivo.QuadPart == 0) {
+                error = "El archivo " + rutaArchivo + " está vacío";
+                return false;
+            }
+            tamano = static_cast<uint64_t>(tamanoArchivo.QuadPart);
+            mapeo = CreateFileMappingA(archivo, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapeo == nullptr) {
+                error = "No se pudo mapear el archivo " + rutaArchivo;
+                return false;
+            }
+            datos = static_cast<const char*>(MapViewOfFile(mapeo, FILE_MAP_READ, 0, 0, 0));
+            if (datos == nullptr) {
+                error = "No se pudo mapear el archivo " + rutaArchivo;
+                return false;
+            }
+#else
+            int descriptor = open(rutaArchivo.c_str(), O_RDONLY);
+            if (descriptor == -1) {
+                error = "No se pudo abrir el archivo " + rutaArchivo;
+                return false;
+            }
+            struct stat informacion;
+            if (fstat(descriptor, &informacion) == -1 || informacion.st_size == 0) {
+                close(descriptor);
+                error = "El archivo " + rutaArchivo + " está vacío";
+                return false;
+            }
+            tamano = static_cast<uint64_t>(informacion.st_size);
+            void* mapeo = mmap(nullptr, tamano, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            close(descriptor); // El mapeo sigue vigente después de cerrar el descriptor
+            if (mapeo == MAP_FAILED) {
+                error = "No se pudo mapear el archivo " + rutaArchivo;
+                return false;
+            }
+            datos = static_cast<const char*>(mapeo);
+#endif
+            return true;
+        }
+
+    public:
+        RedMapeada() {}
+
+        RedMapeada(const RedMapeada&) = delete;
+        RedMapeada& operator=(const RedMapeada&) = delete;
+
+        ~RedMapeada() {
+            cerrar();
+        }
+
+        /**
+         * Abre y valida un archivo de red binario.
+         *
+         * @param rutaArchivo Ruta del archivo.
+         * @return true si el archivo es una red válida, false en caso contrario (ver getError()).
+         */
+        bool abrir(const std::string& rutaArchivo) {
+            cerrar();
+            error.clear();
+            if (!mapear(rutaArchivo)) {
+                cerrar();
+                return false;
+            }
+
+            CabeceraRedBinaria cabecera;
+            if (tamano < sizeof(cabecera)) {
+                error = "El archivo no tiene una cabecera completa";
+                cerrar();
+                return false;
+            }
+            std::memcpy(&cabecera, datos, sizeof(cabecera));
+            if (std::memcmp(cabecera.firma, FIRMA_RED_BINARIA, sizeof(cabecera.firma)) != 0) {
+                error = "El archivo no es una red binaria";
+            } else if (cabecera.version != VERSION_RED_BINARIA) {
+                error = "Versión de red binaria no soportada: " + std::to_string(cabecera.version);
+            } else if (cabecera.marcaOrden != MARCA_ORDEN_BYTES) {
+                error = "El archivo se escribió con otro orden de bytes";
+            } else if (cabecera.numeroCentrosAgua > static_cast<uint32_t>(INT32_MAX - 1) || cabecera.numeroTuberias > static_cast<uint64_t>(INT32_MAX)) {
+                error = "La red es demasiado grande para índices de 32 bits";
+            } else {
+                CabeceraRedBinaria esperada = calcularCabeceraRedBinaria(cabecera.numeroCentrosAgua, cabecera.numeroTuberias);
+                if (std::memcmp(&esperada, &cabecera, sizeof(cabecera)) != 0 || tamano < esperada.tamanoArchivo) {
+                    error = "Las secciones del archivo no coinciden con la cabecera";
+                }
+            }
+            if (!error.empty()) {
+                cerrar();
+                return false;
+            }
+
+            red.inicioAdyacentes = reinterpret_cast<const int32_t*>(datos + cabecera.desplazamientoInicios);
+            red.destinos = reinterpret_cast<const int32_t*>(datos + cabecera.desplazamientoDestinos);
+            red.minutos = reinterpret_cast<const int32_t*>(datos + cabecera.desplazamientoMinutos);
+            red.disponibles.palabras = reinterpret_cast<const uint64_t*>(datos + cabecera.desplazamientoDisponibles);
+            red.numeroCentrosAgua = static_cast<int>(cabecera.numeroCentrosAgua);
+            red.numeroTuberias = static_cast<long long>(cabecera.numeroTuberias);
+            if (red.inicioAdyacentes[0] != 0 || red.inicioAdyacentes[red.numeroCentrosAgua] != red.numeroTuberias) {
+                error = "Los desplazamientos de las tuberías no son válidos";
+                cerrar();
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * Recorre todas las secciones y comprueba que los desplazamientos sean crecientes, que cada destino sea un
+         * centro válido y que los destinos de cada centro estén ordenados y sin repetir (RedCSR::buscarTuberia busca
+         * en ellos por bisección). Es O(V + E); abrir() no lo hace para no tocar todo el archivo.
+         *
+         * @return true si la red es consistente.
+         */
+        bool verificar() {
+            for (int u = 0; u < red.numeroCentrosAgua; ++u) {
+                if (red.inicioAdyacentes[u] > red.inicioAdyacentes[u + 1]) {
+                    error = "Los desplazamientos de las tuberías no son crecientes";
+                    return false;
+                }
+            }
+            for (int u = 0; u < red.numeroCentrosAgua; ++u) {
+                for (int tuberia = red.inicioAdyacentes[u]; tuberia < red.inicioAdyacentes[u + 1]; ++tuberia) {
+                    if (red.destinos[tuberia] < 0 || red.destinos[tuberia] >= red.numeroCentrosAgua || red.minutos[tuberia] < 0) {
+                        error = "Tubería " + std::to_string(tuberia) + " inválida";
+                        return false;
+                    }
+                    if (tuberia > red.inicioAdyacentes[u] && red.destinos[tuberia] <= red.destinos[tuberia - 1]) {
+                        error = "Las tuberías del centro " + std::to_string(u) + " no están ordenadas por destino o se repiten";
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        /**
+         * Obtiene la vista de la red mapeada.
+         *
+         * @return Vista de solo lectura válida mientras el archivo siga abierto.
+         */
+        const RedCSRMapeada& getRed() const {
+            return red;
+        }
+
+        /**
+         * Copia la red mapeada a una instantánea CSR en memoria, por ejemplo para construir unas Rutas editables.
+         *
+         * @return Copia de la red.
+         */
+        RedCSR copiarRedCSR() const {
+            RedCSR copia;
+            copia.inicioAdyacentes.assign(red.inicioAdyacentes, red.inicioAdyacentes + red.numeroCentrosAgua + 1);
+            copia.destinos.assign(red.destinos, red.destinos + red.numeroTuberias);
+            copia.minutos.assign(red.minutos, red.minutos + red.numeroTuberias);
+            copia.disponibles.resize(red.numeroTuberias);
+            for (long long tuberia = 0; tuberia < red.numeroTuberias; ++tuberia) {
+                copia.disponibles[tuberia] = red.disponibles[tuberia] ? 1 : 0;
+            }
+            return copia;
+        }
+
+        /**
+         * Obtiene la descripción del último error de abrir() o verificar().
+         */
+        const std::string& getError() const {
+            return error;
+        }
+};
+
+#endif // FORMATO_BINARIO_H
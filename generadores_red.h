@@ -0,0 +1,155 @@
+#ifndef GENERADORES_RED_H
+#define GENERADORES_RED_H
+
+#include <vector>
+#include <string>
+#include <random>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include "rutas.h"
+
+/*Generadores de redes sintéticas reproducibles para medir el rendimiento. Con la misma semilla y el mismo
+  número de centros generan siempre la misma red, así las mediciones de distintas versiones son comparables.
+  Todas devuelven una instantánea CSR lista para Rutas(RedCSR). */
+
+/**
+ * Genera una cuadrícula tipo calles: cada centro se conecta en ambos sentidos con sus vecinos de arriba, abajo,
+ * izquierda y derecha. El lado es la raíz del número de centros; la última fila puede quedar incompleta.
+ *
+ * @param numeroCentrosAgua Número de centros de agua.
+ * @param semilla Semilla de los minutos de cada tubería (1 a 10).
+ * @return Instantánea CSR de la red.
+ */
+RedCSR generarCuadricula(int numeroCentrosAgua, uint64_t semilla) {
+    std::mt19937_64 generador(semilla);
+    std::uniform_int_distribution<int> minutos(1, 10);
+    int lado = std::max(1, static_cast<int>(std::sqrt(static_cast<double>(numeroCentrosAgua))));
+    std::vector<TuberiaLeida> tuberias;
+    tuberias.reserve(static_cast<size_t>(numeroCentrosAgua) * 4);
+    for (int centro = 0; centro < numeroCentrosAgua; ++centro) {
+        int derecha = centro + 1;
+        int abajo = centro + lado;
+        if (derecha % lado != 0 && derecha < numeroCentrosAgua) {
+            tuberias.push_back({centro, derecha, minutos(generador), true});
+            tuberias.push_back({derecha, centro, minutos(generador), true});
+        }
+        if (abajo < numeroCentrosAgua) {
+            tuberias.push_back({centro, abajo, minutos(generador), true});
+            tuberias.push_back({abajo, centro, minutos(generador), true});
+        }
+    }
+    return construirRedCSR(numeroCentrosAgua, tuberias);
+}
+
+/**
+ * Genera una red aleatoria dispersa: un anillo que garantiza que todo sea alcanzable más tuberías hacia destinos
+ * elegidos al azar, hasta el grado medio pedido.
+ *
+ * @param numeroCentrosAgua Número de centros de agua.
+ * @param gradoMedio Tuberías que salen de cada centro.
+ * @param semilla Semilla del generador.
+ * @return Instantánea CSR de la red.
+ */
+RedCSR generarAleatoriaDispersa(int numeroCentrosAgua, int gradoMedio, uint64_t semilla) {
+    std::mt19937_64 generador(semilla);
+    std::uniform_int_distribution<int> centro(0, numeroCentrosAgua - 1);
+    std::uniform_int_distribution<int> minutos(1, 100);
+    std::vector<TuberiaLeida> tuberias;
+    tuberias.reserve(static_cast<size_t>(numeroCentrosAgua) * gradoMedio);
+    for (int u = 0; u < numeroCentrosAgua; ++u) {
+        tuberias.push_back({u, (u + 1) % numeroCentrosAgua, minutos(generador), true});
+        for (int k = 1; k < gradoMedio; ++k) {
+            tuberias.push_back({u, centro(generador), minutos(generador), true});
+        }
+    }
+    return construirRedCSR(numeroCentrosAgua, tuberias);
+}
+
+/**
+ * Genera una red libre de escala (Barabási–Albert): cada centro nuevo se conecta en ambos sentidos con
+ * enlacesPorCentro centros existentes elegidos con probabilidad proporcional a su grado, lo que produce unos
+ * pocos centros muy conectados.
+ *
+ * @param numeroCentrosAgua Número de centros de agua.
+ * @param enlacesPorCentro Centros existentes a los que se conecta cada centro nuevo.
+ * @param semilla Semilla del generador.
+ * @return Instantánea CSR de la red.
+ */
+RedCSR generarLibreDeEscala(int numeroCentrosAgua, int enlacesPorCentro, uint64_t semilla) {
+    std::mt19937_64 generador(semilla);
+    std::uniform_int_distribution<int> minutos(1, 100);
+    std::vector<TuberiaLeida> tuberias;
+    std::vector<int> extremos; // Cada centro aparece una vez por tubería que toca: elegir al azar aquí es elegir por grado
+    tuberias.reserve(static_cast<size_t>(numeroCentrosAgua) * enlacesPorCentro * 2);
+    extremos.reserve(static_cast<size_t>(numeroCentrosAgua) * enlacesPorCentro * 2);
+    int iniciales = std::min(numeroCentrosAgua, enlacesPorCentro + 1);
+    for (int u = 0; u < iniciales; ++u) {
+        for (int v = u + 1; v < iniciales; ++v) {
+            tuberias.push_back({u, v, minutos(generador), true});
+            tuberias.push_back({v, u, minutos(generador), true});
+            extremos.push_back(u);
+            extremos.push_back(v);
+        }
+    }
+    for (int u = iniciales; u < numeroCentrosAgua; ++u) {
+        size_t extremosAnteriores = extremos.size();
+        for (int k = 0; k < enlacesPorCentro; ++k) {
+            int v = extremosAnteriores == 0 ? 0 : extremos[generador() % extremosAnteriores];
+            tuberias.push_back({u, v, minutos(generador), true});
+            tuberias.push_back({v, u, minutos(generador), true});
+            extremos.push_back(u);
+            extremos.push_back(v);
+        }
+    }
+    return construirRedCSR(numeroCentrosAgua, tuberias);
+}
+
+/**
+ * Genera una cadena larga 0 - 1 - ... - (n - 1) con tuberías en ambos sentidos: el peor caso de profundidad para
+ * las búsquedas y para la reconstrucción de rutas.
+ *
+ * @param numeroCentrosAgua Número de centros de agua.
+ * @param semilla Semilla de los minutos de cada tubería.
+ * @return Instantánea CSR de la red.
+ */
+RedCSR generarCadena(int numeroCentrosAgua, uint64_t semilla) {
+    std::mt19937_64 generador(semilla);
+    std::uniform_int_distribution<int> minutos(1, 10);
+    std::vector<TuberiaLeida> tuberias;
+    tuberias.reserve(static_cast<size_t>(numeroCentrosAgua) * 2);
+    for (int u = 0; u + 1 < numeroCentrosAgua; ++u) {
+        tuberias.push_back({u, u + 1, minutos(generador), true});
+        tuberias.push_back({u + 1, u, minutos(generador), true});
+    }
+    return construirRedCSR(numeroCentrosAgua, tuberias);
+}
+
+/**
+ * Genera una red por nombre: "cuadricula", "aleatoria", "libre_escala", "cadena" o "distrito" (subred de distrito
+ * densa: la red aleatoria con una décima parte de los centros como grado medio; pensada para pocos miles de centros).
+ *
+ * @param tipo Nombre del generador.
+ * @param numeroCentrosAgua Número de centros de agua.
+ * @param semilla Semilla del generador.
+ * @param red Instantánea CSR generada.
+ * @return false si el nombre no corresponde a ningún generador.
+ */
+bool generarRed(const std::string& tipo, int numeroCentrosAgua, uint64_t semilla, RedCSR& red) {
+    if (tipo == "cuadricula") {
+        red = generarCuadricula(numeroCentrosAgua, semilla);
+    } else if (tipo == "aleatoria") {
+        red = generarAleatoriaDispersa(numeroCentrosAgua, 4, semilla);
+    } else if (tipo == "libre_escala") {
+        red = generarLibreDeEscala(numeroCentrosAgua, 3, semilla);
+    } else if (tipo == "cadena") {
+        red = generarCadena(numeroCentrosAgua, semilla);
+    } else if (tipo == "distrito") {
+        red = generarAleatoriaDispersa(numeroCentrosAgua, std::max(4, numeroCentrosAgua / 10), semilla);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+#endif // GENERADORES_RED_H
@@ -150,3 +150,14 @@ def establecer_disponibilidad(u, v):
         G[u][v]['is_available'] = True
     return "Tubería habilitada."
 
+
+def aplicar_cambios(cambios):
+    # Lote de cambios enviado por el hilo de visualización de C++: tuplas (tipo, u, v, minutos)
+    for tipo, u, v, minutos in cambios:
+        if tipo == "agregar":
+            agregar_tuberia(u, v, minutos)
+        elif tipo == "deshabilitar":
+            establecer_no_disponibilidad(u, v)
+        elif tipo == "habilitar":
+            establecer_disponibilidad(u, v)
+    return f"{len(cambios)} cambios aplicados."
@@ -0,0 +1,350 @@
+#ifndef IMPORTADOR_H
+#define IMPORTADOR_H
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include "rutas.h"
+#include "pool_hilos.h"
+
+const int maximoCentrosAutomatico = 1 << 26; // Centros que puede deducir el modo automático (sin numeroCentrosAgua)
+
+/**
+ * Estructura InformeImportacion
+ *
+ * Resumen de una importación masiva: volumen leído, rendimiento y problemas encontrados en la lista de tuberías.
+ */
+struct InformeImportacion {
+    long long bytesLeidos = 0; // Tamaño total leído del archivo
+    long long lineas = 0; // Líneas leídas, incluidas las vacías y los comentarios
+    long long tuberias = 0; // Tuberías que quedaron en la red
+    long long lineasInvalidas = 0; // Líneas que no tienen la forma u,v,minutos[,disponible]
+    long long centrosFueraDeRango = 0; // Tuberías con un centro de agua fuera de [0, numeroCentrosAgua)
+    long long tuberiasDuplicadas = 0; // Tuberías repetidas (se conserva la primera aparición)
+    std::vector<std::string> problemas; // Detalle de los primeros problemas encontrados
+    double segundos = 0; // Tiempo total de la importación
+    double megabytesPorSegundo = 0; // Rendimiento de la importación
+};
+
+/**
+ * Clase ImportadorTuberias
+ *
+ * Importa listas de tuberías en texto de varios gigabytes (una tubería u,v,minutos[,disponible] por línea, líneas
+ * vacías o que empiezan con # ignoradas). El archivo se lee por bloques; cada bloque se corta en tantos trozos como
+ * hilos tenga el pool, siempre en un salto de línea, y los trozos se analizan en paralelo con un analizador de enteros
+ * escrito a mano. Al terminar, las tuberías se reparten por centro de origen con un conteo (una sola pasada) y cada
+ * centro ordena y depura sus propias tuberías, de nuevo en paralelo.
+ *
+ * A diferencia de agregarTuberia, las tuberías repetidas y los centros fuera de rango no se sobrescriben ni se
+ * ignoran en silencio: se cuentan y se detallan en el InformeImportacion.
+ */
+class ImportadorTuberias {
+    private:
+        // Tubería leída junto con la línea del archivo de la que salió, para poder informar problemas
+        struct TuberiaImportada {
+            TuberiaLeida tuberia;
+            long long linea;
+        };
+
+        // Resultado del análisis de un trozo de bloque
+        struct Trozo {
+            const char* inicio = nullptr;
+            const char* fin = nullptr;
+            long long lineas = 0;
+            std::vector<TuberiaImportada> tuberias;
+            std::vector<long long> lineasInvalidas; // Número de línea dentro del trozo
+        };
+
+        PoolHilos& pool; // Hilos para analizar los trozos y ordenar las tuberías
+        size_t tamanoBloque; // Bytes leídos del archivo en cada bloque
+        size_t maximoProblemas; // Cantidad máxima de problemas detallados en el informe
+
+        /**
+         * Lee un entero sin signo avanzando el cursor. Devuelve false si no hay dígitos o si no cabe en 31 bits.
+         */
+        static bool leerEntero(const char*& cursor, const char* fin, int& valor) {
+            const char* inicio = cursor;
+            long long acumulado = 0;
+            while (cursor < fin && *cursor >= '0' && *cursor <= '9') {
+                acumulado = acumulado * 10 + (*cursor++ - '0');
+                if (acumulado > INT32_MAX) {
+                    return false;
+                }
+            }
+            valor = static_cast<int>(acumulado);
+            return cursor != inicio;
+        }
+
+        /**
+         * Avanza el cursor sobre espacios y tabulaciones.
+         */
+        static void saltarEspacios(const char*& cursor, const char* fin) {
+            while (cursor < fin && (*cursor == ' ' || *cursor == '\t')) {
+                cursor++;
+            }
+        }
+
+        /**
+         * Analiza una línea [cursor, fin) sin el salto de línea.
+         *
+         * @return 1 si es una tubería, 0 si es vacía o comentario, -1 si es inválida.
+         */
+        static int analizarLinea(const char* cursor, const char* fin, TuberiaLeida& tuberia) {
+            if (fin > cursor && fin[-1] == '\r') {
+                fin--;
+            }
+            saltarEspacios(cursor, fin);
+            if (cursor == fin || *cursor == '#') {
+                return 0;
+            }
+            int campos[4] = {0, 0, 0, 1};
+            int numeroCampos = 0;
+            while (numeroCampos < 4) {
+                if (!leerEntero(cursor, fin, campos[numeroCampos])) {
+                    return -1;
+                }
+                numeroCampos++;
+                saltarEspacios(cursor, fin);
+                if (cursor == fin || *cursor != ',') {
+                    break;
+                }
+                cursor++;
+                saltarEspacios(cursor, fin);
+            }
+            if (cursor != fin || numeroCampos < 3 || campos[3] > 1) {
+                return -1;
+            }
+            tuberia = {campos[0], campos[1], campos[2], campos[3] == 1};
+            return 1;
+        }
+
+        /**
+         * Analiza todas las líneas completas de un trozo.
+         */
+        static void analizarTrozo(Trozo& trozo) {
+            const char* cursor = trozo.inicio;
+            while (cursor < trozo.fin) {
+                const char* finLinea = static_cast<const char*>(std::memchr(cursor, '\n', trozo.fin - cursor));
+                if (finLinea == nullptr) {
+                    finLinea = trozo.fin;
+                }
+                TuberiaLeida tuberia;
+                int resultado = analizarLinea(cursor, finLinea, tuberia);
+                if (resultado == 1) {
+                    trozo.tuberias.push_back({tuberia, trozo.lineas});
+                } else if (resultado == -1) {
+                    trozo.lineasInvalidas.push_back(trozo.lineas);
+                }
+                trozo.lineas++;
+                cursor = finLinea + 1;
+            }
+        }
+
+        /**
+         * Agrega un problema al informe si aún no se alcanzó el máximo de problemas detallados.
+         */
+        void anotarProblema(InformeImportacion& informe, const std::string& problema) const {
+            if (informe.problemas.size() < maximoProblemas) {
+                informe.problemas.push_back(problema);
+            }
+        }
+
+    public:
+        /**
+         * Constructor de la clase ImportadorTuberias.
+         *
+         * @param pool Pool de hilos para el análisis en paralelo.
+         * @param tamanoBloque Bytes del archivo que se leen por bloque (32 MB por defecto).
+         * @param maximoProblemas Cantidad de problemas que se detallan en el informe.
+         */
+        ImportadorTuberias(PoolHilos& pool, size_t tamanoBloque = 32 << 20, size_t maximoProblemas = 20)
+            : pool(pool), tamanoBloque(tamanoBloque), maximoProblemas(maximoProblemas) {}
+
+        /**
+         * Importa una lista de tuberías y arma la instantánea CSR de la red.
+         *
+         * @param rutaArchivo Ruta de la lista de tuberías.
+         * @param numeroCentrosAgua Número de centros de agua; si es 0 se usa el mayor índice leído más uno. En ese caso
+         *                          los índices desde maximoCentrosAutomatico cuentan como fuera de rango, para que
+         *                          un solo índice erróneo no haga reservar gigabytes.
+         * @param red Instantánea CSR resultante (se puede pasar a Rutas(RedCSR) o a guardarRedBinaria).
+         * @param informe Resumen de la importación.
+         * @return false si el archivo no se pudo leer; los problemas de contenido no hacen fallar la importación.
+         */
+        bool importar(const std::string& rutaArchivo, int numeroCentrosAgua, RedCSR& red, InformeImportacion& informe) {
+            auto comienzo = std::chrono::steady_clock::now();
+            informe = InformeImportacion();
+            std::FILE* archivo = std::fopen(rutaArchivo.c_str(), "rb");
+            if (archivo == nullptr) {
+                anotarProblema(informe, "No se pudo abrir el archivo " + rutaArchivo);
+                return false;
+            }
+
+            int numeroTrozos = pool.getNumeroHilos();
+            std::vector<Trozo> trozos(numeroTrozos);
+            std::vector<TuberiaImportada> tuberias;
+            std::vector<char> bloque(tamanoBloque + 1);
+            size_t arrastrados = 0; // Bytes de una línea incompleta que pasan al siguiente bloque
+            bool finArchivo = false;
+
+            while (!finArchivo) {
+                size_t leidos = std::fread(bloque.data() + arrastrados, 1, bloque.size() - arrastrados, archivo);
+                informe.bytesLeidos += static_cast<long long>(leidos);
+                size_t disponibles = arrastrados + leidos;
+                finArchivo = disponibles < bloque.size();
+                if (disponibles == 0) {
+                    break;
+                }
+
+                // Solo se analizan líneas completas; al final del archivo la última línea puede no tener salto
+                size_t util = disponibles;
+                if (!finArchivo) {
+                    const char* ultimoSalto = nullptr;
+                    for (size_t i = disponibles; i > 0; --i) {
+                        if (bloque[i - 1] == '\n') {
+                            ultimoSalto = bloque.data() + i - 1;
+                            break;
+                        }
+                    }
+                    if (ultimoSalto == nullptr) {
+                        bloque.resize(bloque.size() * 2); // Una sola línea más larga que el bloque
+                        arrastrados = disponibles;
+                        continue;
+                    }
+                    util = static_cast<size_t>(ultimoSalto - bloque.data()) + 1;
+                }
+
+                // Cortar el bloque en trozos que terminan en un salto de línea
+                const char* inicioBloque = bloque.data();
+                const char* finBloque = bloque.data() + util;
+                const char* cursor = inicioBloque;
+                for (int t = 0; t < numeroTrozos; ++t) {
+                    const char* finTrozo = t == numeroTrozos - 1 ? finBloque : inicioBloque + util * (t + 1) / numeroTrozos;
+                    if (finTrozo < cursor) {
+                        finTrozo = cursor;
+                    }
+                    while (finTrozo < finBloque && finTrozo > inicioBloque && finTrozo[-1] != '\n') {
+                        finTrozo++;
+                    }
+                    trozos[t] = Trozo();
+                    trozos[t].inicio = cursor;
+                    trozos[t].fin = finTrozo;
+                    cursor = finTrozo;
+                }
+                pool.paraCada(numeroTrozos, [&](int, int t) { analizarTrozo(trozos[t]); });
+
+                // Unir los trozos en orden, convirtiendo los números de línea locales en globales
+                for (Trozo& trozo : trozos) {
+                    for (TuberiaImportada& tuberia : trozo.tuberias) {
+                        tuberia.linea += informe.lineas + 1;
+                        tuberias.push_back(tuberia);
+                    }
+                    informe.lineasInvalidas += static_cast<long long>(trozo.lineasInvalidas.size());
+                    for (long long linea : trozo.lineasInvalidas) {
+                        anotarProblema(informe, "Linea " + std::to_string(informe.lineas + linea + 1) + " invalida");
+                    }
+                    informe.lineas += trozo.lineas;
+                    trozo = Trozo();
+                }
+
+                arrastrados = disponibles - util;
+                std::copy(bloque.begin() + util, bloque.begin() + disponibles, bloque.begin());
+            }
+            bool errorLectura = std::ferror(archivo) != 0;
+            std::fclose(archivo);
+            if (errorLectura) {
+                anotarProblema(informe, "Error al leer el archivo " + rutaArchivo);
+                return false;
+            }
+
+            // Descartar centros fuera de rango
+            bool automatico = numeroCentrosAgua <= 0;
+            if (automatico) {
+                long long mayorCentro = -1; // En long long: el índice puede ser INT32_MAX
+                for (const TuberiaImportada& tuberia : tuberias) {
+                    long long mayor = std::max(tuberia.tuberia.u, tuberia.tuberia.v);
+                    if (mayor < maximoCentrosAutomatico) {
+                        mayorCentro = std::max(mayorCentro, mayor);
+                    }
+                }
+                numeroCentrosAgua = static_cast<int>(mayorCentro + 1);
+            }
+            size_t validas = 0;
+            for (const TuberiaImportada& tuberia : tuberias) {
+                if (tuberia.tuberia.u >= numeroCentrosAgua || tuberia.tuberia.v >= numeroCentrosAgua) {
+                    informe.centrosFueraDeRango++;
+                    anotarProblema(informe, "Linea " + std::to_string(tuberia.linea) + ": centro de agua fuera de rango ("
+                                   + std::to_string(tuberia.tuberia.u) + " -> " + std::to_string(tuberia.tuberia.v) + ")"
+                                   + (automatico ? ", el maximo sin indicar el numero de centros es "
+                                                   + std::to_string(maximoCentrosAutomatico - 1) : ""));
+                    continue;
+                }
+                tuberias[validas++] = tuberia;
+            }
+            tuberias.resize(validas);
+
+            // Repartir las tuberías por centro de origen conservando el orden del archivo
+            std::vector<int> inicio(numeroCentrosAgua + 1, 0);
+            for (const TuberiaImportada& tuberia : tuberias) {
+                inicio[tuberia.tuberia.u + 1]++;
+            }
+            for (int u = 0; u < numeroCentrosAgua; ++u) {
+                inicio[u + 1] += inicio[u];
+            }
+            std::vector<TuberiaImportada> porOrigen(tuberias.size());
+            {
+                std::vector<int> siguiente(inicio.begin(), inicio.end() - 1);
+                for (const TuberiaImportada& tuberia : tuberias) {
+                    porOrigen[siguiente[tuberia.tuberia.u]++] = tuberia;
+                }
+            }
+            std::vector<TuberiaImportada>().swap(tuberias);
+
+            // Cada centro ordena sus tuberías por destino y marca las repetidas (gana la primera del archivo)
+            std::vector<char> repetida(porOrigen.size(), 0);
+            pool.paraCada(numeroCentrosAgua, [&](int, int u) {
+                auto desde = porOrigen.begin() + inicio[u];
+                auto hasta = porOrigen.begin() + inicio[u + 1];
+                std::stable_sort(desde, hasta, [](const TuberiaImportada& a, const TuberiaImportada& b) {
+                    return a.tuberia.v < b.tuberia.v;
+                });
+                for (int i = inicio[u] + 1; i < inicio[u + 1]; ++i) {
+                    if (porOrigen[i].tuberia.v == porOrigen[i - 1].tuberia.v) {
+                        repetida[i] = 1;
+                    }
+                }
+            });
+
+            red = RedCSR();
+            red.inicioAdyacentes.assign(numeroCentrosAgua + 1, 0);
+            red.destinos.reserve(porOrigen.size());
+            red.minutos.reserve(porOrigen.size());
+            red.disponibles.reserve(porOrigen.size());
+            for (int u = 0; u < numeroCentrosAgua; ++u) {
+                for (int i = inicio[u]; i < inicio[u + 1]; ++i) {
+                    const TuberiaImportada& tuberia = porOrigen[i];
+                    if (repetida[i]) {
+                        informe.tuberiasDuplicadas++;
+                        anotarProblema(informe, "Linea " + std::to_string(tuberia.linea) + ": tuberia " + std::to_string(u) + " -> "
+                                       + std::to_string(tuberia.tuberia.v) + " repetida, se conserva la primera");
+                        continue;
+                    }
+                    red.destinos.push_back(tuberia.tuberia.v);
+                    red.minutos.push_back(tuberia.tuberia.minutos);
+                    red.disponibles.push_back(tuberia.tuberia.disponible ? 1 : 0);
+                }
+                red.inicioAdyacentes[u + 1] = static_cast<int>(red.destinos.size());
+            }
+            informe.tuberias = static_cast<long long>(red.destinos.size());
+
+            informe.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - comienzo).count();
+            informe.megabytesPorSegundo = informe.segundos > 0 ? informe.bytesLeidos / (1024.0 * 1024.0) / informe.segundos : 0;
+            return true;
+        }
+};
+
+#endif // IMPORTADOR_H
@@ -0,0 +1,216 @@
+#ifndef INSTRUMENTACION_H
+#define INSTRUMENTACION_H
+
+#include <ostream>
+
+/*Instrumentación de las rutas calientes: cuenta centros asentados, relajaciones, operaciones de la cola de prioridad
+  y consultas al mapa de tuberías, y mide la duración de las fases de cada consulta en un histograma logarítmico.
+
+  Se compila solo con -DINSTRUMENTAR. Sin esa bandera las macros INSTRUMENTAR_* no generan código y las funciones de
+  volcado quedan vacías, así que el costo es nulo. Con la bandera cada hilo escribe en sus propios contadores (sin
+  atómicos ni cerrojos); el volcado suma los de todos los hilos y debe hacerse cuando no hay búsquedas en curso. */
+
+/**
+ * Eventos que se cuentan.
+ */
+enum EventoInstrumentado {
+    EventoCentroAsentado, // Centro extraído de la cola por Dijkstra
+    EventoRelajacion, // Tubería disponible revisada por Dijkstra
+    EventoColaInsercion, // Elemento nuevo en una cola indexada (montículo, Dial o radix)
+    EventoColaExtraccion, // Extracción del mínimo de una cola indexada
+    EventoColaCambioPrioridad, // Cambio de prioridad de un elemento que ya estaba en la cola
+    EventoConsultaMapa, // Llamada a Rutas::getMinutosParaLlegarYDisponibilidad
+    NumeroEventos
+};
+
+/**
+ * Fases cuya duración se mide.
+ */
+enum FaseInstrumentada {
+    FaseDijkstra, // Búsqueda completa desde un origen (EspacioDijkstra)
+    FaseConsultaRuta, // Consulta de ruta entre dos centros (ConsultaRuta)
+    FaseConsultaJerarquica, // Consulta de ruta sobre la jerarquía de contracción
+    FaseConsultaMapa, // Búsqueda de una tubería en el mapa de Rutas
+    FaseTodosOrigenes, // Cálculo desde todos los orígenes (opción 6)
+    FaseContingencia, // Análisis de contingencias N-1 (analizarContingencias)
+    NumeroFases
+};
+
+#ifdef INSTRUMENTAR
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+const bool instrumentacionActiva = true;
+
+const int cubetasHistograma = 40; // Cubeta i: duraciones en [2^i, 2^(i+1)) nanosegundos
+
+/**
+ * Estructura ContadoresHilo
+ *
+ * Contadores e histogramas de un hilo. Se alinean a una línea de caché para que dos hilos no escriban en la misma.
+ */
+struct alignas(64) ContadoresHilo {
+    long long eventos[NumeroEventos] = {}; // Cantidad de cada evento
+    long long veces[NumeroFases] = {}; // Mediciones de cada fase
+    long long nanosegundosTotales[NumeroFases] = {}; // Suma de las duraciones de cada fase
+    long long nanosegundosMaximo[NumeroFases] = {}; // Mayor duración de cada fase
+    long long histograma[NumeroFases][cubetasHistograma] = {}; // Duraciones de cada fase por potencia de dos
+};
+
+/**
+ * Registro global con los contadores de todos los hilos que instrumentaron algo.
+ */
+struct RegistroInstrumentacion {
+    std::mutex cerrojo; // Protege la lista al registrar un hilo nuevo o al volcar
+    std::vector<std::unique_ptr<ContadoresHilo>> hilos; // Contadores de cada hilo, en orden de registro
+};
+
+RegistroInstrumentacion& registroInstrumentacion() {
+    static RegistroInstrumentacion registro;
+    return registro;
+}
+
+/**
+ * Obtiene los contadores del hilo actual; la primera vez los registra.
+ */
+ContadoresHilo& contadoresHilo() {
+    thread_local ContadoresHilo* propios = nullptr;
+    if (propios == nullptr) {
+        RegistroInstrumentacion& registro = registroInstrumentacion();
+        std::lock_guard<std::mutex> guardia(registro.cerrojo);
+        registro.hilos.push_back(std::make_unique<ContadoresHilo>());
+        propios = registro.hilos.back().get();
+    }
+    return *propios;
+}
+
+/**
+ * Clase MedidorFase
+ *
+ * Mide desde su construcción hasta su destrucción la duración de una fase y la registra en el hilo actual.
+ */
+class MedidorFase {
+    private:
+        FaseInstrumentada fase; // Fase medida
+        std::chrono::steady_clock::time_point inicio; // Momento en que empezó la fase
+
+    public:
+        MedidorFase(FaseInstrumentada fase) : fase(fase), inicio(std::chrono::steady_clock::now()) {}
+
+        MedidorFase(const MedidorFase&) = delete;
+        MedidorFase& operator=(const MedidorFase&) = delete;
+
+        ~MedidorFase() {
+            long long nanosegundos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - inicio).count();
+            ContadoresHilo& contadores = contadoresHilo();
+            int cubeta = 0;
+            while (cubeta + 1 < cubetasHistograma && (nanosegundos >> (cubeta + 1)) > 0) {
+                cubeta++;
+            }
+            contadores.veces[fase]++;
+            contadores.nanosegundosTotales[fase] += nanosegundos;
+            if (nanosegundos > contadores.nanosegundosMaximo[fase]) {
+                contadores.nanosegundosMaximo[fase] = nanosegundos;
+            }
+            contadores.histograma[fase][cubeta]++;
+        }
+};
+
+#define INSTRUMENTAR_CONCATENAR_(a, b) a##b
+#define INSTRUMENTAR_CONCATENAR(a, b) INSTRUMENTAR_CONCATENAR_(a, b)
+#define INSTRUMENTAR_CONTAR(evento) (contadoresHilo().eventos[(evento)]++)
+#define INSTRUMENTAR_SUMAR(evento, cantidad) (contadoresHilo().eventos[(evento)] += (cantidad))
+#define INSTRUMENTAR_FASE(fase) MedidorFase INSTRUMENTAR_CONCATENAR(medidorFase, __LINE__)(fase)
+
+const char* nombresEventos[NumeroEventos] = {"centros_asentados", "relajaciones", "cola_inserciones", "cola_extracciones",
+                                              "cola_cambios_prioridad", "consultas_mapa"};
+const char* nombresFases[NumeroFases] = {"dijkstra", "consulta_ruta", "consulta_jerarquica", "consulta_mapa", "todos_origenes", "contingencia"};
+
+/**
+ * Escribe como un objeto JSON (sin salto de línea) los contadores sumados de todos los hilos, los contadores de
+ * cada hilo y, por fase, la cantidad de mediciones, el tiempo total y máximo en nanosegundos y el histograma (la
+ * posición i cuenta las duraciones entre 2^i y 2^(i+1) nanosegundos).
+ *
+ * @param salida Flujo donde se escribe el JSON.
+ */
+void volcarInstrumentacion(std::ostream& salida) {
+    RegistroInstrumentacion& registro = registroInstrumentacion();
+    std::lock_guard<std::mutex> guardia(registro.cerrojo);
+    ContadoresHilo total;
+    for (const auto& hilo : registro.hilos) {
+        for (int evento = 0; evento < NumeroEventos; ++evento) {
+            total.eventos[evento] += hilo->eventos[evento];
+        }
+        for (int fase = 0; fase < NumeroFases; ++fase) {
+            total.veces[fase] += hilo->veces[fase];
+            total.nanosegundosTotales[fase] += hilo->nanosegundosTotales[fase];
+            if (hilo->nanosegundosMaximo[fase] > total.nanosegundosMaximo[fase]) {
+                total.nanosegundosMaximo[fase] = hilo->nanosegundosMaximo[fase];
+            }
+            for (int cubeta = 0; cubeta < cubetasHistograma; ++cubeta) {
+                total.histograma[fase][cubeta] += hilo->histograma[fase][cubeta];
+            }
+        }
+    }
+
+    auto escribirEventos = [&](const ContadoresHilo& contadores) {
+        salida << "{";
+        for (int evento = 0; evento < NumeroEventos; ++evento) {
+            salida << (evento > 0 ? "," : "") << "\"" << nombresEventos[evento] << "\":" << contadores.eventos[evento];
+        }
+        salida << "}";
+    };
+
+    salida << "{\"instrumentacion\":true,\"contadores\":";
+    escribirEventos(total);
+    salida << ",\"hilos\":[";
+    for (size_t hilo = 0; hilo < registro.hilos.size(); ++hilo) {
+        salida << (hilo > 0 ? "," : "");
+        escribirEventos(*registro.hilos[hilo]);
+    }
+    salida << "],\"fases\":{";
+    for (int fase = 0; fase < NumeroFases; ++fase) {
+        salida << (fase > 0 ? "," : "") << "\"" << nombresFases[fase] << "\":{\"veces\":" << total.veces[fase]
+               << ",\"ns_total\":" << total.nanosegundosTotales[fase] << ",\"ns_maximo\":" << total.nanosegundosMaximo[fase]
+               << ",\"histograma_ns_log2\":[";
+        int ultimaCubeta = cubetasHistograma - 1; // Se omiten las cubetas vacías del final
+        while (ultimaCubeta > 0 && total.histograma[fase][ultimaCubeta] == 0) {
+            ultimaCubeta--;
+        }
+        for (int cubeta = 0; cubeta <= ultimaCubeta; ++cubeta) {
+            salida << (cubeta > 0 ? "," : "") << total.histograma[fase][cubeta];
+        }
+        salida << "]}";
+    }
+    salida << "}}";
+}
+
+/**
+ * Pone en cero los contadores de todos los hilos. Como el volcado, debe llamarse sin búsquedas en curso.
+ */
+void reiniciarInstrumentacion() {
+    RegistroInstrumentacion& registro = registroInstrumentacion();
+    std::lock_guard<std::mutex> guardia(registro.cerrojo);
+    for (auto& hilo : registro.hilos) {
+        *hilo = ContadoresHilo();
+    }
+}
+
+#else
+
+const bool instrumentacionActiva = false;
+
+#define INSTRUMENTAR_CONTAR(evento) ((void)0)
+#define INSTRUMENTAR_SUMAR(evento, cantidad) ((void)0)
+#define INSTRUMENTAR_FASE(fase) ((void)0)
+
+void volcarInstrumentacion(std::ostream&) {}
+
+void reiniciarInstrumentacion() {}
+
+#endif // INSTRUMENTAR
+
+#endif // INSTRUMENTACION_H
@@ -0,0 +1,616 @@
+#ifndef JERARQUIA_CONTRACCION_H
+#define JERARQUIA_CONTRACCION_H
+
+#include <vector>
+#include <climits>
+#include <algorithm>
+#include "rutas.h"
+#include "cola_prioridad.h"
+#include "consulta_ruta.h"
+#include "instrumentacion.h"
+
+/*Jerarquía de contracción para consultas de ruta muy rápidas sobre una red que cambia poco.
+
+  Preprocesamiento: los centros se contraen de a uno, del menos al más importante. Al contraer un centro v, para cada
+  par de vecinos u -> v -> w se busca un camino testigo de u a w que no pase por v y que no sea más largo; si no existe
+  se agrega un atajo u -> w con los minutos de u -> v -> w. El orden de contracción es el nivel de cada centro. Cuando
+  la red que queda se vuelve demasiado densa la contracción se detiene y los centros restantes forman un núcleo sin
+  jerarquía. Preparar la red es rápido en cuadrículas, cadenas y redes parecidas a las viales; en redes aleatorias o
+  libres de escala el núcleo queda grande (del 20 al 40 % de los centros con 10000) y la búsqueda dentro de él, con
+  todos los atajos, es mucho más lenta que Dijkstra bidireccional sobre la red original: unas 47 veces en una red
+  aleatoria de 10000 centros. Por eso, si el núcleo no queda chico (ver nucleoMaximoUtil), la consulta no usa la
+  jerarquía y responde con Dijkstra bidireccional.
+
+  Consulta: Dijkstra bidireccional que desde el origen solo sube de nivel y desde el destino solo sube de nivel por las
+  tuberías invertidas. Las dos búsquedas exploran unos pocos cientos de centros incluso en redes muy grandes. Los
+  atajos guardan el centro por el que pasan, así la ruta completa se desempaqueta sin volver a buscar.
+
+  La jerarquía se calcula sobre las tuberías disponibles en ese momento. Si después cambia la red (una tubería nueva o
+  un cambio de disponibilidad), la consulta lo detecta y vuelve a Dijkstra bidireccional hasta que se prepare de nuevo
+  la jerarquía; si la red vuelve a quedar igual que al prepararla, la jerarquía vuelve a usarse. */
+
+const int nucleoMaximoUtil = 64; // Centros del núcleo que se toleran siempre; además se tolera el 1 % de la red
+
+/**
+ * Estructura ArcoJerarquia
+ *
+ * Tubería o atajo de la jerarquía.
+ */
+struct ArcoJerarquia {
+    int centro; // Centro del otro extremo del arco
+    int minutos; // Minutos del arco
+    int medio; // Centro contraído por el que pasa el atajo, o -1 si es una tubería original
+};
+
+/**
+ * Clase JerarquiaContraccion
+ *
+ * Resultado del preprocesamiento: nivel de cada centro y, en formato CSR, los arcos que suben de nivel.
+ */
+class JerarquiaContraccion {
+    private:
+        int numeroCentrosAgua = 0; // Número de centros de agua
+        std::vector<int> nivel; // Orden de contracción de cada centro
+        std::vector<int> inicioSubidaAdelante; // Desplazamiento de los arcos que salen de cada centro hacia uno de mayor nivel
+        std::vector<ArcoJerarquia> subidaAdelante; // Arcos u -> w con nivel[w] > nivel[u] o entre centros del núcleo, guardados en u y ordenados por w
+        std::vector<int> inicioSubidaAtras; // Desplazamiento de los arcos que llegan a cada centro desde uno de mayor nivel
+        std::vector<ArcoJerarquia> subidaAtras; // Arcos u -> w con nivel[u] > nivel[w] o entre centros del núcleo, guardados en w y ordenados por u
+        long long numeroAtajos = 0; // Atajos agregados por la contracción
+        int numeroNucleo = 0; // Centros que quedaron sin contraer
+        bool nucleoPequeno = false; // Indica si el núcleo quedó chico y la jerarquía acelera las consultas
+        bool construida = false; // Indica si ya se preparó
+        unsigned long long versionConstruccion = 0; // Versión de la red al preparar la jerarquía
+        std::vector<int> destinosConstruccion; // Copia de la red al preparar la jerarquía, para reconocer si vuelve a quedar igual
+        std::vector<int> minutosConstruccion;
+        std::vector<char> disponiblesConstruccion;
+        unsigned long long versionComprobada = 0; // Última versión de la red comparada con la copia
+        bool vigenteComprobada = false; // Resultado de esa comparación
+
+        /**
+         * Busca dentro de un rango de arcos ordenado el que llega o sale del centro indicado.
+         */
+        static const ArcoJerarquia* buscarArco(const std::vector<ArcoJerarquia>& arcos, int inicio, int fin, int centro) {
+            auto it = std::lower_bound(arcos.begin() + inicio, arcos.begin() + fin, centro,
+                                       [](const ArcoJerarquia& arco, int valor) { return arco.centro < valor; });
+            return it != arcos.begin() + fin && it->centro == centro ? &*it : nullptr;
+        }
+
+        /**
+         * Pasa listas de arcos por centro al formato CSR, ordenando cada lista por el centro del otro extremo.
+         */
+        static void compactar(std::vector<std::vector<ArcoJerarquia>>& listas, std::vector<int>& inicio, std::vector<ArcoJerarquia>& arcos) {
+            inicio.assign(listas.size() + 1, 0);
+            arcos.clear();
+            for (size_t centro = 0; centro < listas.size(); ++centro) {
+                std::sort(listas[centro].begin(), listas[centro].end(),
+                          [](const ArcoJerarquia& a, const ArcoJerarquia& b) { return a.centro < b.centro; });
+                arcos.insert(arcos.end(), listas[centro].begin(), listas[centro].end());
+                inicio[centro + 1] = static_cast<int>(arcos.size());
+                std::vector<ArcoJerarquia>().swap(listas[centro]);
+            }
+        }
+
+    public:
+        /**
+         * Prepara (o vuelve a preparar) la jerarquía con las tuberías disponibles de la red.
+         *
+         * @param G Red de tuberías de agua.
+         * @param limiteTestigo Centros que puede asentar cada búsqueda de testigos; un límite bajo prepara más rápido
+         *                      a cambio de algunos atajos innecesarios (nunca afecta a los resultados).
+         * @param gradoNucleo Grado medio de la red de trabajo a partir del cual se deja de contraer; los centros que
+         *                    quedan forman el núcleo.
+         */
+        void construir(Rutas& G, int limiteTestigo = 500, int gradoNucleo = 32) {
+            const RedCSR& red = G.getRedCSR();
+            numeroCentrosAgua = G.getNumeroCentrosAgua();
+            int n = numeroCentrosAgua;
+
+            // Red de trabajo: arcos salientes y entrantes de los centros aún no contraídos
+            std::vector<std::vector<ArcoJerarquia>> salientes(n), entrantes(n);
+            long long arcosTrabajo = 0; // Arcos de la red de trabajo
+            for (int u = 0; u < n; ++u) {
+                for (int tuberia = red.inicioAdyacentes[u]; tuberia < red.inicioAdyacentes[u + 1]; ++tuberia) {
+                    int v = red.destinos[tuberia];
+                    if (red.disponibles[tuberia] && v != u) {
+                        salientes[u].push_back({v, red.minutos[tuberia], -1});
+                        entrantes[v].push_back({u, red.minutos[tuberia], -1});
+                        arcosTrabajo++;
+                    }
+                }
+            }
+            std::vector<std::vector<ArcoJerarquia>> listasAdelante(n), listasAtras(n);
+            std::vector<int> vecinosContraidos(n, 0);
+            nivel.assign(n, 0);
+            numeroAtajos = 0;
+
+            // Búsqueda de testigos: Dijkstra acotado en la red de trabajo, sin pasar por el centro que se contrae
+            std::vector<int> minutosTestigo(n);
+            std::vector<unsigned int> marcaTestigo(n, 0);
+            unsigned int busqueda = 0;
+            ColaPrioridadIndexada<> colaTestigo(n);
+            auto leerTestigo = [&](int centro) {
+                return marcaTestigo[centro] == busqueda ? minutosTestigo[centro] : INT_MAX;
+            };
+            std::vector<unsigned int> marcaObjetivo(n, 0); // Búsqueda en la que cada centro es destino de un testigo
+            auto buscarTestigos = [&](int origen, int excluido, long long limiteMinutos, int limiteAsentados) {
+                if (++busqueda == 0) {
+                    std::fill(marcaTestigo.begin(), marcaTestigo.end(), 0);
+                    std::fill(marcaObjetivo.begin(), marcaObjetivo.end(), 0);
+                    busqueda = 1;
+                }
+                // La búsqueda termina apenas se asientan todos los vecinos de salida del centro que se contrae
+                int objetivosPendientes = 0;
+                for (const ArcoJerarquia& salida : salientes[excluido]) {
+                    if (salida.centro != origen && marcaObjetivo[salida.centro] != busqueda) {
+                        marcaObjetivo[salida.centro] = busqueda;
+                        objetivosPendientes++;
+                    }
+                }
+                colaTestigo.vaciar();
+                marcaTestigo[origen] = busqueda;
+                minutosTestigo[origen] = 0;
+                colaTestigo.insertar(origen, 0);
+                // En la parte alta de la jerarquía los centros tienen muchos arcos: además de los asentados se limitan
+                // las tuberías revisadas, para que cada búsqueda cueste lo mismo en cualquier parte de la red
+                int asentados = 0;
+                long long revisados = 0;
+                long long limiteRevisados = 8LL * limiteAsentados;
+                while (objetivosPendientes > 0 && !colaTestigo.isEmpty() && colaTestigo.prioridadMinima() <= limiteMinutos &&
+                       asentados < limiteAsentados && revisados < limiteRevisados) {
+                    int actual = colaTestigo.extraerMinimo();
+                    asentados++;
+                    if (marcaObjetivo[actual] == busqueda) {
+                        objetivosPendientes--;
+                    }
+                    revisados += static_cast<long long>(salientes[actual].size());
+                    for (const ArcoJerarquia& arco : salientes[actual]) {
+                        if (arco.centro == excluido) {
+                            continue;
+                        }
+                        long long nuevosMinutos = static_cast<long long>(minutosTestigo[actual]) + arco.minutos;
+                        if (nuevosMinutos < leerTestigo(arco.centro)) {
+                            marcaTestigo[arco.centro] = busqueda;
+                            minutosTestigo[arco.centro] = static_cast<int>(nuevosMinutos);
+                            colaTestigo.insertarODecrementar(arco.centro, static_cast<int>(nuevosMinutos));
+                        }
+                    }
+                }
+            };
+
+            // Agrega un atajo u -> w o mejora el arco existente
+            auto agregarArco = [&](int u, int w, int minutos, int medio) {
+                for (ArcoJerarquia& arco : salientes[u]) {
+                    if (arco.centro == w) {
+                        if (minutos < arco.minutos) {
+                            arco.minutos = minutos;
+                            arco.medio = medio;
+                            for (ArcoJerarquia& inverso : entrantes[w]) {
+                                if (inverso.centro == u) {
+                                    inverso.minutos = minutos;
+                                    inverso.medio = medio;
+                                }
+                            }
+                        }
+                        return;
+                    }
+                }
+                salientes[u].push_back({w, minutos, medio});
+                entrantes[w].push_back({u, minutos, medio});
+                numeroAtajos++;
+                arcosTrabajo++;
+            };
+
+            // Cuenta (y si aplicar es verdadero, agrega) los atajos que necesita la contracción de v
+            auto contarAtajos = [&](int v, bool aplicar) {
+                int atajos = 0;
+                int maximoSaliente = 0;
+                for (const ArcoJerarquia& salida : salientes[v]) {
+                    maximoSaliente = std::max(maximoSaliente, salida.minutos);
+                }
+                for (const ArcoJerarquia& entrada : entrantes[v]) {
+                    // Al estimar la prioridad basta una búsqueda corta; al contraer se busca con el límite completo
+                    buscarTestigos(entrada.centro, v, static_cast<long long>(entrada.minutos) + maximoSaliente, aplicar ? limiteTestigo : limiteTestigo / 10 + 1);
+                    for (const ArcoJerarquia& salida : salientes[v]) {
+                        long long minutosPorV = static_cast<long long>(entrada.minutos) + salida.minutos;
+                        if (salida.centro == entrada.centro || leerTestigo(salida.centro) <= minutosPorV || minutosPorV >= INT_MAX) {
+                            continue;
+                        }
+                        atajos++;
+                        if (aplicar) {
+                            agregarArco(entrada.centro, salida.centro, static_cast<int>(minutosPorV), v);
+                        }
+                    }
+                }
+                return atajos;
+            };
+
+            // Prioridad de contracción: atajos que agrega menos arcos que quita (diferencia de arcos), más los vecinos
+            // ya contraídos, que reparten la contracción de forma pareja por toda la red
+            auto prioridad = [&](int v) {
+                int arcos = static_cast<int>(salientes[v].size() + entrantes[v].size());
+                return contarAtajos(v, false) - arcos + vecinosContraidos[v];
+            };
+
+            // Orden de contracción con actualización perezosa: la prioridad del mínimo se recalcula antes de contraerlo
+            ColaPrioridadIndexada<> orden(n);
+            for (int v = 0; v < n; ++v) {
+                orden.insertar(v, prioridad(v));
+            }
+            int siguienteNivel = 0;
+            while (!orden.isEmpty()) {
+                // En redes sin separadores pequeños (aleatorias, libres de escala) los últimos centros quedan unidos
+                // casi todos con todos y contraerlos costaría más que todo lo anterior: ahí se detiene la contracción
+                if (arcosTrabajo > static_cast<long long>(gradoNucleo) * (n - siguienteNivel)) {
+                    break;
+                }
+                int v = orden.extraerMinimo();
+                int prioridadActual = prioridad(v);
+                if (!orden.isEmpty() && prioridadActual > orden.prioridadMinima()) {
+                    orden.insertar(v, prioridadActual);
+                    continue;
+                }
+
+                contarAtajos(v, true);
+                arcosTrabajo -= static_cast<long long>(salientes[v].size() + entrantes[v].size());
+                for (const ArcoJerarquia& salida : salientes[v]) {
+                    listasAdelante[v].push_back(salida);
+                    auto& lista = entrantes[salida.centro];
+                    lista.erase(std::remove_if(lista.begin(), lista.end(), [v](const ArcoJerarquia& arco) { return arco.centro == v; }), lista.end());
+                    vecinosContraidos[salida.centro]++;
+                }
+                for (const ArcoJerarquia& entrada : entrantes[v]) {
+                    listasAtras[v].push_back(entrada);
+                    auto& lista = salientes[entrada.centro];
+                    lista.erase(std::remove_if(lista.begin(), lista.end(), [v](const ArcoJerarquia& arco) { return arco.centro == v; }), lista.end());
+                    vecinosContraidos[entrada.centro]++;
+                }
+                std::vector<ArcoJerarquia>().swap(salientes[v]);
+                std::vector<ArcoJerarquia>().swap(entrantes[v]);
+                nivel[v] = siguienteNivel++;
+            }
+
+            // Núcleo: los centros sin contraer comparten el nivel más alto y conservan todos sus arcos en los dos
+            // sentidos, así la consulta hace entre ellos un Dijkstra bidireccional común
+            numeroNucleo = n - siguienteNivel;
+            nucleoPequeno = numeroNucleo <= std::max(nucleoMaximoUtil, n / 100);
+            while (!orden.isEmpty()) {
+                int v = orden.extraerMinimo();
+                nivel[v] = siguienteNivel;
+                listasAdelante[v] = std::move(salientes[v]);
+                listasAtras[v] = std::move(entrantes[v]);
+            }
+
+            compactar(listasAdelante, inicioSubidaAdelante, subidaAdelante);
+            compactar(listasAtras, inicioSubidaAtras, subidaAtras);
+
+            construida = true;
+            versionConstruccion = G.getVersion();
+            versionComprobada = versionConstruccion;
+            vigenteComprobada = true;
+            destinosConstruccion = red.destinos;
+            minutosConstruccion = red.minutos;
+            disponiblesConstruccion = red.disponibles;
+        }
+
+        /**
+         * Indica si la jerarquía sigue correspondiendo a la red. Si la red cambió desde la última comprobación se
+         * compara una vez con la copia tomada al prepararla; entre cambios la respuesta queda guardada, así que
+         * varios hilos pueden consultar a la vez siempre que uno la haya comprobado antes de repartir las consultas.
+         *
+         * @param G Red de tuberías de agua.
+         * @return true si la jerarquía está preparada y la red es igual a la que se usó para prepararla.
+         */
+        bool esVigente(Rutas& G) {
+            if (!construida) {
+                return false;
+            }
+            if (G.getVersion() != versionComprobada) {
+                const RedCSR& red = G.getRedCSR();
+                vigenteComprobada = red.destinos == destinosConstruccion && red.minutos == minutosConstruccion &&
+                                    red.disponibles == disponiblesConstruccion;
+                versionComprobada = G.getVersion();
+            }
+            return vigenteComprobada;
+        }
+
+        /**
+         * Indica si construir terminó y la jerarquía puede consultarse.
+         */
+        bool estaConstruida() const {
+            return construida;
+        }
+
+        /**
+         * Obtiene el número de atajos agregados al contraer los centros.
+         */
+        long long getNumeroAtajos() const {
+            return numeroAtajos;
+        }
+
+        /**
+         * Obtiene el número de centros del núcleo, los que quedaron sin contraer.
+         */
+        int getNumeroNucleo() const {
+            return numeroNucleo;
+        }
+
+        /**
+         * Indica si el núcleo quedó chico (a lo sumo nucleoMaximoUtil centros o el 1 % de la red). Si no, consultar
+         * con la jerarquía es más lento que Dijkstra bidireccional y ConsultaJerarquica no la usa.
+         */
+        bool tieneNucleoPequeno() const {
+            return nucleoPequeno;
+        }
+
+        /**
+         * Obtiene el número de centros de agua de la red con que se construyó la jerarquía.
+         */
+        int getNumeroCentrosAgua() const {
+            return numeroCentrosAgua;
+        }
+
+        /**
+         * Obtiene el desplazamiento de los arcos que suben desde cada centro, como RedCSR::inicioAdyacentes.
+         */
+        const std::vector<int>& getInicioSubidaAdelante() const {
+            return inicioSubidaAdelante;
+        }
+
+        /**
+         * Obtiene los arcos que suben hacia adelante, agrupados por centro de salida.
+         */
+        const std::vector<ArcoJerarquia>& getSubidaAdelante() const {
+            return subidaAdelante;
+        }
+
+        /**
+         * Obtiene el desplazamiento de los arcos que suben hacia atrás desde cada centro.
+         */
+        const std::vector<int>& getInicioSubidaAtras() const {
+            return inicioSubidaAtras;
+        }
+
+        /**
+         * Obtiene los arcos que suben hacia atrás, agrupados por centro de llegada.
+         */
+        const std::vector<ArcoJerarquia>& getSubidaAtras() const {
+            return subidaAtras;
+        }
+
+        /**
+         * Desempaqueta un arco de la jerarquía y agrega a la ruta los centros que recorre, sin incluir el inicial.
+         *
+         * @param u Centro de salida del arco.
+         * @param w Centro de llegada del arco.
+         * @param medio Centro contraído del atajo, o -1 si es una tubería original.
+         * @param centros Ruta a la que se agregan los centros.
+         */
+        void desempaquetar(int u, int w, int medio, std::vector<int>& centros) const {
+            // Tramos por desempaquetar, en orden inverso de recorrido
+            struct Tramo {
+                int salida;
+                int llegada;
+                int medio;
+            };
+            std::vector<Tramo> pendientes = {{u, w, medio}};
+            while (!pendientes.empty()) {
+                Tramo tramo = pendientes.back();
+                pendientes.pop_back();
+                if (tramo.medio == -1) {
+                    centros.push_back(tramo.llegada);
+                    continue;
+                }
+                // El medio tiene menor nivel que ambos extremos: salida -> medio está guardado en el medio como
+                // arco que baja, y medio -> llegada como arco que sube
+                const ArcoJerarquia* primero = buscarArco(subidaAtras, inicioSubidaAtras[tramo.medio], inicioSubidaAtras[tramo.medio + 1], tramo.salida);
+                const ArcoJerarquia* segundo = buscarArco(subidaAdelante, inicioSubidaAdelante[tramo.medio], inicioSubidaAdelante[tramo.medio + 1], tramo.llegada);
+                pendientes.push_back({tramo.medio, tramo.llegada, segundo->medio});
+                pendientes.push_back({tramo.salida, tramo.medio, primero->medio});
+            }
+        }
+};
+
+/**
+ * Clase ConsultaJerarquica
+ *
+ * Consultas de ruta sobre una jerarquía de contracción, con buffers marcados por número de consulta como ConsultaRuta.
+ * Si la jerarquía no está preparada, su núcleo quedó grande o la red cambió desde que se preparó, responde con
+ * Dijkstra bidireccional.
+ * Cada hilo debe usar su propia instancia.
+ */
+class ConsultaJerarquica {
+    private:
+        JerarquiaContraccion& jerarquia; // Jerarquía preparada
+        Rutas& G; // Red de tuberías de agua
+        ConsultaRuta respaldo; // Consulta sin jerarquía, para cuando la jerarquía no vale
+        unsigned int consultaActual = 0; // Número de la consulta en curso
+        std::vector<unsigned int> marcaAdelante; // Consulta en la que se tocó cada centro hacia adelante
+        std::vector<unsigned int> marcaAtras; // Consulta en la que se tocó cada centro hacia atrás
+        std::vector<int> minutosAdelante; // Minutos desde el origen
+        std::vector<int> minutosAtras; // Minutos hasta el destino
+        std::vector<int> arcoAdelante; // Arco por el que se llegó a cada centro desde el origen (-1 en el origen)
+        std::vector<int> previoAdelante; // Centro desde el que se llegó
+        std::vector<int> arcoAtras; // Arco por el que cada centro sigue hacia el destino (-1 en el destino)
+        std::vector<int> siguienteAtras; // Centro siguiente hacia el destino
+        ColaPrioridadIndexada<> colaAdelante; // Cola de la búsqueda hacia adelante
+        ColaPrioridadIndexada<> colaAtras; // Cola de la búsqueda hacia atrás
+        bool usoJerarquia = false; // Indica si la última consulta usó la jerarquía
+        long long centrosAsentados = 0; // Centros extraídos de las colas en la última consulta
+
+        int leerAdelante(int centro) const {
+            return marcaAdelante[centro] == consultaActual ? minutosAdelante[centro] : INT_MAX;
+        }
+
+        int leerAtras(int centro) const {
+            return marcaAtras[centro] == consultaActual ? minutosAtras[centro] : INT_MAX;
+        }
+
+        /**
+         * Consulta sobre la jerarquía: las dos búsquedas solo suben de nivel (dentro del núcleo recorren todos los arcos). Un centro se "detiene" (no se expande)
+         * si un centro de mayor nivel ya alcanzado da un camino más corto hasta él: su valor no puede ser parte de
+         * la ruta más corta.
+         */
+        RutaConsultada rutaJerarquica(int centroAguaOrigen, int centroAguaDestino) {
+            const std::vector<int>& inicioAdelante = jerarquia.getInicioSubidaAdelante();
+            const std::vector<ArcoJerarquia>& adelante = jerarquia.getSubidaAdelante();
+            const std::vector<int>& inicioAtras = jerarquia.getInicioSubidaAtras();
+            const std::vector<ArcoJerarquia>& atras = jerarquia.getSubidaAtras();
+
+            if (++consultaActual == 0) {
+                std::fill(marcaAdelante.begin(), marcaAdelante.end(), 0);
+                std::fill(marcaAtras.begin(), marcaAtras.end(), 0);
+                consultaActual = 1;
+            }
+            colaAdelante.vaciar();
+            colaAtras.vaciar();
+
+            marcaAdelante[centroAguaOrigen] = consultaActual;
+            minutosAdelante[centroAguaOrigen] = 0;
+            arcoAdelante[centroAguaOrigen] = -1;
+            colaAdelante.insertar(centroAguaOrigen, 0);
+            marcaAtras[centroAguaDestino] = consultaActual;
+            minutosAtras[centroAguaDestino] = 0;
+            arcoAtras[centroAguaDestino] = -1;
+            colaAtras.insertar(centroAguaDestino, 0);
+
+            long long mejoresMinutos = centroAguaOrigen == centroAguaDestino ? 0 : LLONG_MAX;
+            int encuentro = centroAguaOrigen == centroAguaDestino ? centroAguaOrigen : -1;
+
+            while (true) {
+                long long minimoAdelante = colaAdelante.isEmpty() ? LLONG_MAX : colaAdelante.prioridadMinima();
+                long long minimoAtras = colaAtras.isEmpty() ? LLONG_MAX : colaAtras.prioridadMinima();
+                if (std::min(minimoAdelante, minimoAtras) >= mejoresMinutos) {
+                    break; // También termina cuando ambas colas quedan vacías
+                }
+                bool haciaAdelante = minimoAdelante <= minimoAtras;
+                ColaPrioridadIndexada<>& cola = haciaAdelante ? colaAdelante : colaAtras;
+                int actual = cola.extraerMinimo();
+                centrosAsentados++;
+                int minutosActual = haciaAdelante ? minutosAdelante[actual] : minutosAtras[actual];
+
+                // Encuentro de las dos búsquedas
+                int minutosOtroLado = haciaAdelante ? leerAtras(actual) : leerAdelante(actual);
+                if (minutosOtroLado != INT_MAX && static_cast<long long>(minutosActual) + minutosOtroLado < mejoresMinutos) {
+                    mejoresMinutos = static_cast<long long>(minutosActual) + minutosOtroLado;
+                    encuentro = actual;
+                }
+
+                if (haciaAdelante) {
+                    bool detenido = false;
+                    for (int posicion = inicioAtras[actual]; posicion < inicioAtras[actual + 1] && !detenido; ++posicion) {
+                        int superior = leerAdelante(atras[posicion].centro);
+                        detenido = superior != INT_MAX && static_cast<long long>(superior) + atras[posicion].minutos < minutosActual;
+                    }
+                    if (detenido) {
+                        continue;
+                    }
+                    for (int posicion = inicioAdelante[actual]; posicion < inicioAdelante[actual + 1]; ++posicion) {
+                        const ArcoJerarquia& arco = adelante[posicion];
+                        long long nuevosMinutos = static_cast<long long>(minutosActual) + arco.minutos;
+                        if (nuevosMinutos < leerAdelante(arco.centro)) {
+                            marcaAdelante[arco.centro] = consultaActual;
+                            minutosAdelante[arco.centro] = static_cast<int>(nuevosMinutos);
+                            arcoAdelante[arco.centro] = posicion;
+                            previoAdelante[arco.centro] = actual;
+                            colaAdelante.insertarODecrementar(arco.centro, static_cast<int>(nuevosMinutos));
+                        }
+                    }
+                } else {
+                    bool detenido = false;
+                    for (int posicion = inicioAdelante[actual]; posicion < inicioAdelante[actual + 1] && !detenido; ++posicion) {
+                        int superior = leerAtras(adelante[posicion].centro);
+                        detenido = superior != INT_MAX && static_cast<long long>(superior) + adelante[posicion].minutos < minutosActual;
+                    }
+                    if (detenido) {
+                        continue;
+                    }
+                    for (int posicion = inicioAtras[actual]; posicion < inicioAtras[actual + 1]; ++posicion) {
+                        const ArcoJerarquia& arco = atras[posicion];
+                        long long nuevosMinutos = static_cast<long long>(minutosActual) + arco.minutos;
+                        if (nuevosMinutos < leerAtras(arco.centro)) {
+                            marcaAtras[arco.centro] = consultaActual;
+                            minutosAtras[arco.centro] = static_cast<int>(nuevosMinutos);
+                            arcoAtras[arco.centro] = posicion;
+                            siguienteAtras[arco.centro] = actual;
+                            colaAtras.insertarODecrementar(arco.centro, static_cast<int>(nuevosMinutos));
+                        }
+                    }
+                }
+            }
+
+            RutaConsultada resultado;
+            if (encuentro == -1) {
+                return resultado;
+            }
+            resultado.minutos = static_cast<int>(mejoresMinutos);
+
+            // Arcos desde el origen hasta el encuentro (en orden inverso) y desde el encuentro hasta el destino
+            std::vector<int> subida;
+            for (int centro = encuentro; arcoAdelante[centro] != -1; centro = previoAdelante[centro]) {
+                subida.push_back(centro);
+            }
+            resultado.centros.push_back(centroAguaOrigen);
+            for (auto it = subida.rbegin(); it != subida.rend(); ++it) {
+                int centro = *it;
+                jerarquia.desempaquetar(previoAdelante[centro], centro, adelante[arcoAdelante[centro]].medio, resultado.centros);
+            }
+            for (int centro = encuentro; arcoAtras[centro] != -1; centro = siguienteAtras[centro]) {
+                jerarquia.desempaquetar(centro, siguienteAtras[centro], atras[arcoAtras[centro]].medio, resultado.centros);
+            }
+            return resultado;
+        }
+
+    public:
+        /**
+         * Constructor de la clase ConsultaJerarquica.
+         *
+         * @param jerarquia Jerarquía de contracción (puede prepararse o volver a prepararse después).
+         * @param G Red de tuberías de agua.
+         */
+        ConsultaJerarquica(JerarquiaContraccion& jerarquia, Rutas& G)
+            : jerarquia(jerarquia), G(G), respaldo(G),
+              marcaAdelante(G.getNumeroCentrosAgua(), 0), marcaAtras(G.getNumeroCentrosAgua(), 0),
+              minutosAdelante(G.getNumeroCentrosAgua()), minutosAtras(G.getNumeroCentrosAgua()),
+              arcoAdelante(G.getNumeroCentrosAgua()), previoAdelante(G.getNumeroCentrosAgua()),
+              arcoAtras(G.getNumeroCentrosAgua()), siguienteAtras(G.getNumeroCentrosAgua()),
+              colaAdelante(G.getNumeroCentrosAgua()), colaAtras(G.getNumeroCentrosAgua()) {}
+
+        /**
+         * Calcula la ruta más corta entre dos centros de agua, con la jerarquía si sigue valiendo para la red y su núcleo
+         * quedó chico.
+         *
+         * @param centroAguaOrigen Índice del centro de agua de origen.
+         * @param centroAguaDestino Índice del centro de agua de destino.
+         * @return Minutos y centros de la ruta; minutos es INT_MAX y la ruta está vacía si no hay camino.
+         */
+        RutaConsultada ruta(int centroAguaOrigen, int centroAguaDestino) {
+            INSTRUMENTAR_FASE(FaseConsultaJerarquica);
+            centrosAsentados = 0;
+            usoJerarquia = jerarquia.esVigente(G) && jerarquia.tieneNucleoPequeno() &&
+                           jerarquia.getNumeroCentrosAgua() == G.getNumeroCentrosAgua();
+            if (!usoJerarquia) {
+                RutaConsultada resultado = respaldo.ruta(centroAguaOrigen, centroAguaDestino, true);
+                centrosAsentados = respaldo.getCentrosAsentados();
+                return resultado;
+            }
+            RutaConsultada resultado = rutaJerarquica(centroAguaOrigen, centroAguaDestino);
+            INSTRUMENTAR_SUMAR(EventoCentroAsentado, centrosAsentados);
+            return resultado;
+        }
+
+        /**
+         * Indica si la última consulta se respondió con la jerarquía (falso si se usó Dijkstra bidireccional).
+         */
+        bool getUsoJerarquia() const {
+            return usoJerarquia;
+        }
+
+        /**
+         * Obtiene la cantidad de centros extraídos de las colas en la última consulta.
+         */
+        long long getCentrosAsentados() const {
+            return centrosAsentados;
+        }
+};
+
+#endif // JERARQUIA_CONTRACCION_H
@@ -0,0 +1,258 @@
+#ifndef MATRIZ_DISTANCIAS_H
+#define MATRIZ_DISTANCIAS_H
+
+#include <vector>
+#include <climits>
+#include <cmath>
+#include <algorithm>
+#include "rutas.h"
+#include "pool_hilos.h"
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#endif
+
+/*Matriz de minutos entre todos los pares de centros para subredes de distrito densas (unos pocos miles de centros
+  muy interconectados), donde un núcleo de Floyd–Warshall (min-plus) ajustado le gana a V búsquedas de Dijkstra.
+
+  La matriz se recorre por bloques de ladoBloque x ladoBloque (Floyd–Warshall por bloques): para cada bloque diagonal
+  k primero se cierra el propio bloque (k, k), luego los de su fila y su columna, y al final todos los demás. Los
+  bloques de cada fase son independientes y se reparten entre los hilos del pool. Cada bloque de 64 x 64 enteros
+  ocupa 16 KB, así que los tres que intervienen en una actualización caben en la caché. Compilando con -mavx2 (o
+  -march=native) el bucle interno relaja ocho columnas por instrucción y actualiza los previos con una mezcla por
+  máscara; sin AVX2 queda un bucle escalar que el compilador puede vectorizar por su cuenta.
+
+  Sin camino se representa con sinCaminoMatriz = INT_MAX / 2 para que la suma de dos tramos no desborde; la matriz
+  solo se usa si el camino simple más largo posible (maxMinutos * (V - 1)) queda por debajo de ese valor.
+
+  Con tuberías de 0 minutos, Floyd–Warshall puede dejar previos que forman un ciclo de costo cero y la ruta no se
+  podría reconstruir. En ese caso cada tubería vale minutos * V + 1 dentro de la matriz: se compara primero por
+  minutos y, a igualdad, por cantidad de tuberías (siempre menor que V), así ningún ciclo cuesta cero. */
+
+const int sinCaminoMatriz = INT_MAX / 2; // Minutos de un par sin camino dentro de la matriz
+const int ladoBloque = 64; // Lado de los bloques de la matriz (múltiplo de los 8 enteros de un registro AVX2)
+// Costos aproximados en nanosegundos, medidos con benchmark_rutas sobre las redes "distrito" y "aleatoria"
+const double nanosegundosPorRelajacion = 8.0; // Tubería revisada por Dijkstra
+const double nanosegundosPorAsentado = 14.0; // Centro asentado por Dijkstra, por log2 del número de centros
+#if defined(__AVX2__)
+const double nanosegundosPorCelda = 0.4; // Celda de la matriz relajada por un centro intermedio, con AVX2
+#else
+const double nanosegundosPorCelda = 1.7; // Lo mismo con el bucle escalar
+#endif
+
+/**
+ * Clase MatrizDistancias
+ *
+ * Minutos y centro previo de la ruta más corta entre cada par de centros de agua. La fila del origen i es el mismo
+ * resultado que daría Dijkstra desde i: minutos hacia cada destino y previo de cada destino en su ruta.
+ */
+class MatrizDistancias {
+    private:
+        int numeroCentrosAgua = 0; // Número de centros de agua
+        int paso = 0; // Enteros por fila: numeroCentrosAgua redondeado a un múltiplo de ladoBloque
+        int escala = 1; // Valor de un minuto dentro de la matriz: 1, o V si hay tuberías de 0 minutos
+        std::vector<int> minutos; // Minutos de i a j en minutos[i * paso + j]
+        std::vector<int> previo; // Centro previo a j en la ruta de i a j, o -1
+
+        /**
+         * Obtiene la escala de la red (ver el comentario del archivo) y su mayor cantidad de minutos por tubería.
+         */
+        static int calcularEscala(const RedCSR& red, long long& maxMinutos) {
+            bool hayCeros = false;
+            maxMinutos = 0;
+            for (size_t tuberia = 0; tuberia < red.destinos.size(); ++tuberia) {
+                if (red.disponibles[tuberia]) {
+                    hayCeros = hayCeros || red.minutos[tuberia] == 0;
+                    maxMinutos = std::max<long long>(maxMinutos, red.minutos[tuberia]);
+                }
+            }
+            return hayCeros ? static_cast<int>(red.inicioAdyacentes.size()) - 1 : 1;
+        }
+
+        /**
+         * Relaja el tramo [inicioJ, inicioJ + ladoBloque) de la fila i pasando por el centro k.
+         */
+        void relajarFila(int i, int k, int inicioJ) {
+            int minutosIK = minutos[static_cast<size_t>(i) * paso + k];
+            if (minutosIK >= sinCaminoMatriz) {
+                return;
+            }
+            const int* minutosK = &minutos[static_cast<size_t>(k) * paso + inicioJ];
+            const int* previoK = &previo[static_cast<size_t>(k) * paso + inicioJ];
+            int* minutosI = &minutos[static_cast<size_t>(i) * paso + inicioJ];
+            int* previoI = &previo[static_cast<size_t>(i) * paso + inicioJ];
+#if defined(__AVX2__)
+            const __m256i tramo = _mm256_set1_epi32(minutosIK);
+            for (int j = 0; j < ladoBloque; j += 8) {
+                __m256i actual = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(minutosI + j));
+                __m256i candidato = _mm256_add_epi32(tramo, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(minutosK + j)));
+                __m256i mejora = _mm256_cmpgt_epi32(actual, candidato);
+                if (_mm256_testz_si256(mejora, mejora)) {
+                    continue; // Lo más común cuando la matriz ya está casi cerrada: ni minutos ni previos cambian
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(minutosI + j), _mm256_min_epi32(actual, candidato));
+                __m256i previos = _mm256_blendv_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(previoI + j)),
+                                                     _mm256_loadu_si256(reinterpret_cast<const __m256i*>(previoK + j)), mejora);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(previoI + j), previos);
+            }
+#else
+            for (int j = 0; j < ladoBloque; ++j) {
+                int candidato = minutosIK + minutosK[j];
+                bool mejora = candidato < minutosI[j];
+                minutosI[j] = mejora ? candidato : minutosI[j];
+                previoI[j] = mejora ? previoK[j] : previoI[j];
+            }
+#endif
+        }
+
+        /**
+         * Relaja el bloque (bloqueI, bloqueJ) pasando por los centros del bloque bloqueK. Si el bloque está en la
+         * fila k, sus filas son a la vez las que se usan como intermedias y el orden clásico (k afuera) es
+         * obligatorio. En el resto ninguna fila del bloque es intermedia, así que cada fila se cierra entera antes
+         * de pasar a la siguiente y se queda en la caché de primer nivel. Actualizar en el lugar es correcto porque
+         * la fila y la columna k no cambian durante la iteración k (minutos[k][k] = 0).
+         */
+        void relajarBloque(int bloqueI, int bloqueJ, int bloqueK) {
+            const int inicioI = bloqueI * ladoBloque;
+            const int inicioJ = bloqueJ * ladoBloque;
+            const int inicioK = bloqueK * ladoBloque;
+            if (bloqueI == bloqueK) {
+                for (int k = inicioK; k < inicioK + ladoBloque; ++k) {
+                    for (int i = inicioI; i < inicioI + ladoBloque; ++i) {
+                        relajarFila(i, k, inicioJ);
+                    }
+                }
+            } else {
+                for (int i = inicioI; i < inicioI + ladoBloque; ++i) {
+                    for (int k = inicioK; k < inicioK + ladoBloque; ++k) {
+                        relajarFila(i, k, inicioJ);
+                    }
+                }
+            }
+        }
+
+    public:
+        /**
+         * Decide si conviene la matriz en lugar de una búsqueda de Dijkstra por origen. La matriz relaja V^3 celdas;
+         * V búsquedas relajan V * T tuberías y asientan V^2 centros a log2(V) cada uno. Con los costos medidos de
+         * cada operación la matriz gana cuando la red es densa. También se exige que la matriz entre en memoria y
+         * que sus minutos, ya escalados, no puedan llegar a sinCaminoMatriz.
+         *
+         * @param red Instantánea compacta de la red.
+         * @param maxCentros Mayor número de centros para el que se arma la matriz (4096 ocupan 128 MB).
+         * @return Verdadero si conviene calcular la matriz.
+         */
+        static bool convieneMatriz(const RedCSR& red, int maxCentros = 4096) {
+            long long centros = static_cast<long long>(red.inicioAdyacentes.size()) - 1;
+            if (centros < ladoBloque || centros > maxCentros) {
+                return false;
+            }
+            long long maxMinutos;
+            long long escalaRed = calcularEscala(red, maxMinutos);
+            if ((maxMinutos * escalaRed + (escalaRed > 1)) * (centros - 1) >= sinCaminoMatriz) {
+                return false;
+            }
+            long long tuberias = std::count(red.disponibles.begin(), red.disponibles.end(), 1);
+            double v = static_cast<double>(centros);
+            double costoDijkstra = v * (nanosegundosPorRelajacion * tuberias + nanosegundosPorAsentado * v * std::log2(v));
+            double costoMatriz = nanosegundosPorCelda * v * v * v;
+            return costoMatriz < costoDijkstra;
+        }
+
+        /**
+         * Calcula la matriz con las tuberías disponibles de la red. Los minutos de la red deben cumplir el límite
+         * que revisa convieneMatriz; el número de centros puede superar el suyo si hay memoria.
+         *
+         * @param red Instantánea compacta de la red.
+         * @param pool Hilos que reparten los bloques de cada fase.
+         */
+        void construir(const RedCSR& red, PoolHilos& pool) {
+            numeroCentrosAgua = static_cast<int>(red.inicioAdyacentes.size()) - 1;
+            int bloques = (numeroCentrosAgua + ladoBloque - 1) / ladoBloque;
+            paso = bloques * ladoBloque + 16; // 64 bytes más por fila: las filas de un bloque no caen en el mismo conjunto de la caché
+            long long maxMinutos;
+            escala = calcularEscala(red, maxMinutos);
+            int extra = escala > 1 ? 1 : 0; // Una tubería más en la ruta, para desempatar
+            minutos.assign(static_cast<size_t>(paso) * paso, sinCaminoMatriz); // El relleno queda sin camino y no participa
+            previo.assign(static_cast<size_t>(paso) * paso, -1);
+            for (int u = 0; u < numeroCentrosAgua; ++u) {
+                minutos[static_cast<size_t>(u) * paso + u] = 0;
+                for (int tuberia = red.inicioAdyacentes[u]; tuberia < red.inicioAdyacentes[u + 1]; ++tuberia) {
+                    int v = red.destinos[tuberia];
+                    size_t posicion = static_cast<size_t>(u) * paso + v;
+                    int valor = red.minutos[tuberia] * escala + extra;
+                    if (red.disponibles[tuberia] && v != u && valor < minutos[posicion]) {
+                        minutos[posicion] = valor;
+                        previo[posicion] = u;
+                    }
+                }
+            }
+
+            for (int k = 0; k < bloques; ++k) {
+                // Fase 1: el bloque diagonal
+                relajarBloque(k, k, k);
+                // Fase 2: los bloques de la fila y la columna k, que solo dependen del diagonal
+                if (bloques > 1) {
+                    pool.paraCada(2 * (bloques - 1), [&](int, int tarea) {
+                        int otro = tarea / 2 < k ? tarea / 2 : tarea / 2 + 1;
+                        if (tarea % 2 == 0) {
+                            relajarBloque(k, otro, k);
+                        } else {
+                            relajarBloque(otro, k, k);
+                        }
+                    });
+                    // Fase 3: el resto, que depende de su bloque en la fila k y de su bloque en la columna k
+                    pool.paraCada((bloques - 1) * (bloques - 1), [&](int, int tarea) {
+                        int i = tarea / (bloques - 1);
+                        int j = tarea % (bloques - 1);
+                        relajarBloque(i < k ? i : i + 1, j < k ? j : j + 1, k);
+                    });
+                }
+            }
+        }
+
+        /**
+         * Obtiene el número de centros de agua de la matriz.
+         */
+        int getNumeroCentrosAgua() const {
+            return numeroCentrosAgua;
+        }
+
+        /**
+         * Obtiene los minutos de la ruta más corta de i a j.
+         *
+         * @return Minutos, o INT_MAX si no hay camino.
+         */
+        int getMinutos(int i, int j) const {
+            int valor = minutos[static_cast<size_t>(i) * paso + j];
+            return valor >= sinCaminoMatriz ? INT_MAX : valor / escala;
+        }
+
+        /**
+         * Obtiene el centro previo a j en la ruta más corta desde i.
+         *
+         * @return Índice del centro previo, o -1 si j es el origen o no hay camino.
+         */
+        int getPrevio(int i, int j) const {
+            return previo[static_cast<size_t>(i) * paso + j];
+        }
+
+        /**
+         * Copia la fila de un origen con el formato de Dijkstra (INT_MAX y -1 en los centros sin camino), lista para
+         * reconstruirRuta o para seguir el origen en modo dinámico.
+         *
+         * @param origen Índice del centro de agua de origen.
+         * @param minutosFila Vector donde se escriben los minutos hacia cada centro.
+         * @param previoFila Vector donde se escribe el centro previo de cada centro.
+         */
+        void copiarFila(int origen, std::vector<int>& minutosFila, std::vector<int>& previoFila) const {
+            minutosFila.resize(numeroCentrosAgua);
+            previoFila.resize(numeroCentrosAgua);
+            for (int j = 0; j < numeroCentrosAgua; ++j) {
+                minutosFila[j] = getMinutos(origen, j);
+                previoFila[j] = getPrevio(origen, j);
+            }
+        }
+};
+
+#endif // MATRIZ_DISTANCIAS_H
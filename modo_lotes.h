@@ -0,0 +1,332 @@
+#ifndef MODO_LOTES_H
+#define MODO_LOTES_H
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <climits>
+#include <algorithm>
+#include "rutas.h"
+#include "pool_hilos.h"
+#include "todos_origenes.h"
+#include "origen_optimo.h"
+#include "consulta_ruta.h"
+#include "jerarquia_contraccion.h"
+#include "cache_arboles.h"
+#include "contingencia.h"
+#include "exportar_red.h"
+#include "instrumentacion.h"
+
+/*Modo por lotes del menú: lee comandos de un flujo (normalmente una tubería desde otro programa), los ejecuta uno
+  tras otro sin limpiar la pantalla ni esperar teclas, y escribe una línea compacta por comando.
+
+  Comandos (uno por línea; las líneas vacías y las que empiezan con # se ignoran):
+    agregar u v minutos   ->  ok
+    deshabilitar u v      ->  ok | error tuberia inexistente
+    habilitar u v         ->  ok | error tuberia inexistente
+    ruta u v              ->  ruta u v minutos c0 c1 ... ck | ruta u v -
+    optimo [objetivo]     ->  optimo origen minutosTotales minutosMaximo centrosInalcanzables
+                              (objetivo: minutos, el de la opción 6 y el predeterminado; maximo; alcanzables)
+    desde u               ->  desde u minutosTotales minutosMaximo centrosInalcanzables   (árbol de rutas de u, con caché)
+    cache [limiteBytes]   ->  cache aciertos revalidados fallos invalidados expulsados arboles bytes   (cambia el límite si se da)
+    contingencia k [origen ...]
+                          ->  contingencia analizadas criticas u v perdidos minutos ...   (las k tuberías más críticas
+                              con impacto; sin orígenes se usa el origen óptimo, y varios orígenes abastecen juntos)
+    exportar archivo      ->  ok | error no se pudo escribir   (DOT, o GraphML si termina en .graphml)
+    preparar              ->  ok atajos   (prepara la jerarquía de contracción para las consultas de ruta)
+    estadisticas          ->  {json} | error instrumentacion desactivada   (contadores de instrumentacion.h)
+    reiniciar_estadisticas -> ok | error instrumentacion desactivada
+    salir                 ->  termina el modo por lotes
+  Un comando mal formado responde "error <motivo>" y no detiene el lote.
+  Después de "preparar" las rutas se responden con la jerarquía mientras la red siga igual que al prepararla; si la
+  red cambia se responden con Dijkstra bidireccional hasta el siguiente "preparar". Si la contracción dejó un núcleo
+  grande (redes aleatorias o libres de escala) la jerarquía sería más lenta y las rutas siguen con Dijkstra
+  bidireccional. */
+
+/**
+ * Clase ProcesadorLotes
+ *
+ * Ejecuta los comandos del modo por lotes sobre una red. Las consultas de ruta consecutivas son de solo lectura, así
+ * que se acumulan y se resuelven juntas en paralelo (una ConsultaJerarquica por hilo) antes del siguiente comando que
+ * modifique la red o cuando ya no quedan comandos esperando en la entrada. Las respuestas salen en el orden de los
+ * comandos.
+ */
+class ProcesadorLotes {
+    private:
+        // Consulta de ruta pendiente y su respuesta
+        struct ConsultaPendiente {
+            int origen;
+            int destino;
+            RutaConsultada ruta;
+        };
+
+        Rutas& G; // Red de tuberías de agua
+        PoolHilos& pool; // Hilos para las consultas agrupadas y el origen óptimo
+        JerarquiaContraccion jerarquia; // Jerarquía de contracción, preparada con el comando preparar
+        std::vector<std::unique_ptr<ConsultaJerarquica>> consultasPorHilo; // Buffers de consulta de cada hilo, creados al primer uso
+        std::vector<ConsultaPendiente> pendientes; // Consultas de ruta acumuladas
+        CacheArboles cacheArboles; // Árboles de rutas de los orígenes pedidos con el comando desde
+        bool optimoVigente = false; // Indica si el último origen óptimo calculado sigue valiendo para la red actual
+        ObjetivoOrigen objetivoOptimo = ObjetivoMinutosTotales; // Objetivo con el que se calculó el último origen óptimo
+        int origenOptimo = -1; // Último origen óptimo calculado
+        ResumenOrigen resumenOptimo{}; // Resumen del último origen óptimo calculado
+
+        /**
+         * Verifica que un índice corresponda a un centro de agua de la red.
+         */
+        bool esCentroValido(int centro) {
+            return centro >= 0 && centro < G.getNumeroCentrosAgua();
+        }
+
+        /**
+         * Resuelve las consultas de ruta acumuladas y escribe sus respuestas en orden.
+         */
+        void resolverPendientes(std::ostream& salida) {
+            if (pendientes.empty()) {
+                return;
+            }
+            // Las instantáneas y la vigencia de la jerarquía se resuelven aquí, antes de repartir las consultas:
+            // dentro de los hilos solo se leen
+            G.getRedCSR();
+            G.getRedInversaCSR();
+            jerarquia.esVigente(G);
+            if (consultasPorHilo.empty()) {
+                for (int hilo = 0; hilo < pool.getNumeroHilos(); ++hilo) {
+                    consultasPorHilo.push_back(std::make_unique<ConsultaJerarquica>(jerarquia, G));
+                }
+            }
+
+            auto resolver = [this](int hilo, int indice) {
+                ConsultaPendiente& consulta = pendientes[indice];
+                consulta.ruta = consultasPorHilo[hilo]->ruta(consulta.origen, consulta.destino);
+            };
+            if (pendientes.size() == 1) {
+                resolver(0, 0);
+            } else {
+                pool.paraCada(static_cast<int>(pendientes.size()), resolver);
+            }
+
+            for (const ConsultaPendiente& consulta : pendientes) {
+                salida << "ruta " << consulta.origen << " " << consulta.destino;
+                if (consulta.ruta.minutos == INT_MAX) {
+                    salida << " -";
+                } else {
+                    salida << " " << consulta.ruta.minutos;
+                    for (int centro : consulta.ruta.centros) {
+                        salida << " " << centro;
+                    }
+                }
+                salida << '\n';
+            }
+            pendientes.clear();
+        }
+
+        /**
+         * Calcula el origen óptimo según el objetivo, salvo que la red y el objetivo no hayan cambiado desde el último.
+         */
+        void asegurarOptimo(ObjetivoOrigen objetivo) {
+            if (!optimoVigente || objetivo != objetivoOptimo) {
+                ResultadoOrigenOptimo resultado = buscarOrigenOptimo(G, pool, objetivo);
+                origenOptimo = resultado.origenOptimo;
+                resumenOptimo = resultado.resumen;
+                objetivoOptimo = objetivo;
+                optimoVigente = true;
+            }
+        }
+
+        /**
+         * Calcula (o reutiliza, si la red y el objetivo no cambiaron) el origen óptimo y escribe su resumen.
+         */
+        void responderOptimo(ObjetivoOrigen objetivo, std::ostream& salida) {
+            asegurarOptimo(objetivo);
+            salida << "optimo " << origenOptimo << " " << resumenOptimo.minutosTotales << " " << resumenOptimo.minutosMaximo
+                   << " " << resumenOptimo.centrosInalcanzables << '\n';
+        }
+
+        /**
+         * Analiza la falla de cada tubería desde los orígenes dados (o el origen óptimo) y escribe las más críticas.
+         */
+        void responderContingencia(std::istringstream& argumentos, std::ostream& salida) {
+            int limite;
+            if (!(argumentos >> limite) || limite < 0) {
+                salida << "error se esperaba: contingencia k [origen ...]\n";
+                return;
+            }
+            std::vector<int> origenes;
+            int origen;
+            while (argumentos >> origen) {
+                if (!esCentroValido(origen)) {
+                    salida << "error centro fuera de rango\n";
+                    return;
+                }
+                origenes.push_back(origen);
+            }
+            if (origenes.empty()) {
+                asegurarOptimo(ObjetivoMinutosTotales);
+                origenes.push_back(origenOptimo);
+            }
+
+            ResultadoContingencia resultado = analizarContingencias(G, pool, origenes);
+            salida << "contingencia " << resultado.impactos.size() << " " << resultado.tuberiasCriticas;
+            int listadas = std::min(limite, resultado.tuberiasCriticas); // Las críticas van primero
+            for (int i = 0; i < listadas; ++i) {
+                const ImpactoFalla& impacto = resultado.impactos[i];
+                salida << " " << impacto.u << " " << impacto.v << " " << impacto.centrosPerdidos << " " << impacto.minutosAdicionales;
+            }
+            salida << '\n';
+        }
+
+        /**
+         * Ejecuta un comando de modificación o el cálculo del origen óptimo.
+         */
+        void ejecutar(const std::string& comando, std::istringstream& argumentos, std::ostream& salida) {
+            int u, v, minutos;
+            if (comando == "agregar") {
+                if (!(argumentos >> u >> v >> minutos)) {
+                    salida << "error se esperaba: agregar u v minutos\n";
+                } else if (!esCentroValido(u) || !esCentroValido(v) || minutos < 0) {
+                    salida << "error centro o minutos fuera de rango\n";
+                } else {
+                    G.agregarTuberia(u, v, minutos);
+                    optimoVigente = false;
+                    salida << "ok\n";
+                }
+            } else if (comando == "deshabilitar" || comando == "habilitar") {
+                if (!(argumentos >> u >> v)) {
+                    salida << "error se esperaba: " << comando << " u v\n";
+                } else if (!esCentroValido(u) || !esCentroValido(v)) {
+                    salida << "error centro fuera de rango\n";
+                } else if (G.establecerDisponibilidad(u, v, comando == "habilitar")) {
+                    optimoVigente = false;
+                    salida << "ok\n";
+                } else {
+                    salida << "error tuberia inexistente\n";
+                }
+            } else if (comando == "optimo") {
+                std::string nombre;
+                ObjetivoOrigen objetivo = ObjetivoMinutosTotales;
+                if (argumentos >> nombre && !leerObjetivoOrigen(nombre, objetivo)) {
+                    salida << "error objetivo desconocido: " << nombre << " (minutos, maximo o alcanzables)\n";
+                } else {
+                    responderOptimo(objetivo, salida);
+                }
+            } else if (comando == "desde") {
+                if (!(argumentos >> u)) {
+                    salida << "error se esperaba: desde u\n";
+                } else if (!esCentroValido(u)) {
+                    salida << "error centro fuera de rango\n";
+                } else {
+                    const ArbolCacheado& arbol = cacheArboles.obtener(u);
+                    long long minutosTotales = 0;
+                    int minutosMaximo = 0;
+                    int centrosInalcanzables = 0;
+                    for (int minutosCentro : arbol.minutosParaLlegarAcumulados) {
+                        if (minutosCentro == INT_MAX) {
+                            centrosInalcanzables++;
+                        } else {
+                            minutosTotales += minutosCentro;
+                            minutosMaximo = std::max(minutosMaximo, minutosCentro);
+                        }
+                    }
+                    salida << "desde " << u << " " << minutosTotales << " " << minutosMaximo << " " << centrosInalcanzables << '\n';
+                }
+            } else if (comando == "cache") {
+                long long limite;
+                if (argumentos >> limite) {
+                    cacheArboles.setLimiteBytes(static_cast<size_t>(std::max(0LL, limite)));
+                }
+                const EstadisticasCache& estadisticas = cacheArboles.getEstadisticas();
+                salida << "cache " << estadisticas.aciertos << " " << estadisticas.revalidados << " " << estadisticas.fallos << " "
+                       << estadisticas.invalidados << " " << estadisticas.expulsados << " " << cacheArboles.getNumeroArboles() << " "
+                       << cacheArboles.getBytesUsados() << '\n';
+            } else if (comando == "contingencia") {
+                responderContingencia(argumentos, salida);
+            } else if (comando == "preparar") {
+                jerarquia.construir(G);
+                salida << "ok " << jerarquia.getNumeroAtajos() << '\n';
+            } else if (comando == "estadisticas" || comando == "reiniciar_estadisticas") {
+                if (!instrumentacionActiva) {
+                    salida << "error instrumentacion desactivada (compilar con -DINSTRUMENTAR)\n";
+                } else if (comando == "estadisticas") {
+                    volcarInstrumentacion(salida);
+                    salida << '\n';
+                } else {
+                    reiniciarInstrumentacion();
+                    salida << "ok\n";
+                }
+            } else if (comando == "exportar") {
+                std::string archivo;
+                if (!(argumentos >> archivo)) {
+                    salida << "error se esperaba: exportar archivo\n";
+                } else if (exportarRed(G.getRedCSR(), archivo)) {
+                    salida << "ok\n";
+                } else {
+                    salida << "error no se pudo escribir " << archivo << "\n";
+                }
+            } else {
+                salida << "error comando desconocido: " << comando << '\n';
+            }
+        }
+
+    public:
+        /**
+         * Constructor de la clase ProcesadorLotes.
+         *
+         * @param G Red de tuberías de agua sobre la que se ejecutan los comandos.
+         * @param pool Hilos para las consultas agrupadas y el cálculo del origen óptimo.
+         */
+        ProcesadorLotes(Rutas& G, PoolHilos& pool) : G(G), pool(pool), cacheArboles(G) {}
+
+        /**
+         * Lee y ejecuta comandos hasta "salir" o el fin de la entrada. La salida se vacía cuando ya no quedan
+         * comandos esperando en la entrada, así quien envía comandos de a uno recibe cada respuesta sin demora y
+         * quien envía muchos no paga un vaciado por línea.
+         *
+         * @param entrada Flujo de comandos.
+         * @param salida Flujo de respuestas.
+         * @return Cantidad de comandos ejecutados.
+         */
+        long long procesar(std::istream& entrada, std::ostream& salida) {
+            G.setMostrarMensajes(false);
+            long long comandos = 0;
+            std::string linea;
+            while (std::getline(entrada, linea)) {
+                std::istringstream argumentos(linea);
+                std::string comando;
+                if (!(argumentos >> comando) || comando[0] == '#') {
+                    continue;
+                }
+                comandos++;
+                if (comando == "salir") {
+                    break;
+                }
+                if (comando == "ruta") {
+                    int u, v;
+                    if (!(argumentos >> u >> v)) {
+                        resolverPendientes(salida);
+                        salida << "error se esperaba: ruta u v\n";
+                    } else if (!esCentroValido(u) || !esCentroValido(v)) {
+                        resolverPendientes(salida);
+                        salida << "error centro fuera de rango\n";
+                    } else {
+                        pendientes.push_back({u, v, RutaConsultada()});
+                    }
+                } else {
+                    resolverPendientes(salida);
+                    ejecutar(comando, argumentos, salida);
+                }
+                if (entrada.rdbuf()->in_avail() <= 0) {
+                    resolverPendientes(salida);
+                    salida.flush();
+                }
+            }
+            resolverPendientes(salida);
+            salida.flush();
+            G.setMostrarMensajes(true);
+            return comandos;
+        }
+};
+
+#endif // MODO_LOTES_H
@@ -0,0 +1,224 @@
+#ifndef ORIGEN_OPTIMO_H
+#define ORIGEN_OPTIMO_H
+
+#include <vector>
+#include <string>
+#include <climits>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+#include "rutas.h"
+#include "dijkstra.h"
+#include "pool_hilos.h"
+#include "todos_origenes.h"
+#include "instrumentacion.h"
+
+/*Búsqueda del origen óptimo por ramificación y poda. A diferencia de calcularTodosOrigenes, que termina las V
+  búsquedas para poder listar el resumen de cada origen, aquí solo interesa el mejor, así que la búsqueda de un
+  candidato se abandona apenas se sabe que no puede superar al mejor encontrado hasta el momento.
+
+  Cotas: Dijkstra asienta los centros en orden de minutos creciente, así que si ya se asentaron k centros con suma S y
+  el último a d minutos, cada centro que falte llegará en d minutos o más (o no llegará). Un candidato solo puede
+  empatar en centros alcanzados con el mejor si llega al menos a tantos como él, de modo que sus minutos totales son
+  como mínimo S + (alcanzadosMejor - k) * d y su máximo es como mínimo d. La poda solo se usa cuando se sabe que el
+  candidato no alcanza más centros que el mejor: si el mejor llega a toda la red, o si el candidato está dentro del
+  alcance del mejor (entonces todo lo que alcanza el candidato también lo alcanza el mejor).
+
+  Los candidatos se evalúan primero los de más tuberías disponibles (entrantes y salientes) y, a igualdad, los de
+  tuberías más rápidas: suelen estar cerca del centro de la red y dan pronto una buena cota. Los hilos del pool toman
+  los candidatos en ese orden de un contador compartido y comparten el mejor bajo un cerrojo. El resultado no depende
+  del reparto entre hilos: los empates se resuelven siempre por el índice menor. */
+
+/**
+ * Objetivos para elegir el origen óptimo. En todos un centro sin camino cuenta como infinitamente lejano, así que
+ * primero se comparan los centros alcanzados.
+ */
+enum ObjetivoOrigen {
+    ObjetivoMinutosTotales, // Más centros alcanzados y, a igualdad, menos minutos totales (la opción 6)
+    ObjetivoMinutosMaximo, // Más centros alcanzados y, a igualdad, menor tiempo al centro más lejano (centro de la red)
+    ObjetivoAlcanzables // Más centros alcanzados, sin importar los minutos
+};
+
+/**
+ * Obtiene el objetivo con el nombre dado ("minutos", "maximo" o "alcanzables").
+ *
+ * @return false si el nombre no corresponde a ningún objetivo.
+ */
+bool leerObjetivoOrigen(const std::string& nombre, ObjetivoOrigen& objetivo) {
+    if (nombre == "minutos") {
+        objetivo = ObjetivoMinutosTotales;
+    } else if (nombre == "maximo") {
+        objetivo = ObjetivoMinutosMaximo;
+    } else if (nombre == "alcanzables") {
+        objetivo = ObjetivoAlcanzables;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Estructura ResultadoOrigenOptimo
+ *
+ * Origen óptimo, su resumen exacto, su árbol de rutas y cuánto trabajo ahorró la poda.
+ */
+struct ResultadoOrigenOptimo {
+    int origenOptimo = -1; // Mejor centro de agua según el objetivo
+    ResumenOrigen resumen; // Resumen completo del origen óptimo
+    std::vector<int> minutosOrigenOptimo; // Tiempos acumulados desde el origen óptimo
+    std::vector<int> previoOrigenOptimo; // Centros de agua previos en las rutas desde el origen óptimo
+    int candidatosDescartados = 0; // Candidatos descartados sin buscar (dentro del alcance del mejor, sin poder superarlo)
+    int busquedasPodadas = 0; // Búsquedas abandonadas antes de terminar
+    long long centrosAsentados = 0; // Centros asentados en todas las búsquedas
+};
+
+/**
+ * Compara dos orígenes según el objetivo; los empates se resuelven por el índice menor.
+ */
+bool esMejorOrigenSegun(ObjetivoOrigen objetivo, const ResumenOrigen& a, int origenA, const ResumenOrigen& b, int origenB) {
+    if (a.centrosInalcanzables != b.centrosInalcanzables) {
+        return a.centrosInalcanzables < b.centrosInalcanzables;
+    }
+    if (objetivo == ObjetivoMinutosMaximo && a.minutosMaximo != b.minutosMaximo) {
+        return a.minutosMaximo < b.minutosMaximo;
+    }
+    if (objetivo != ObjetivoAlcanzables && a.minutosTotales != b.minutosTotales) {
+        return a.minutosTotales < b.minutosTotales;
+    }
+    return origenA < origenB;
+}
+
+/**
+ * Busca el origen óptimo según el objetivo, podando las búsquedas que no pueden superar al mejor.
+ *
+ * @param G Red de tuberías de agua.
+ * @param pool Pool de hilos que reparte los candidatos.
+ * @param objetivo Criterio para comparar orígenes.
+ * @return Origen óptimo con su resumen y su árbol de rutas.
+ */
+ResultadoOrigenOptimo buscarOrigenOptimo(Rutas& G, PoolHilos& pool, ObjetivoOrigen objetivo = ObjetivoMinutosTotales) {
+    INSTRUMENTAR_FASE(FaseTodosOrigenes);
+    int numeroCentrosAgua = G.getNumeroCentrosAgua();
+    const RedCSR& red = G.getRedCSR();
+    const RedInversaCSR& inversa = G.getRedInversaCSR();
+    ResultadoOrigenOptimo resultado;
+
+    // Orden heurístico de los candidatos: más tuberías disponibles y, a igualdad, menos minutos por tubería
+    std::vector<int> candidatos(numeroCentrosAgua);
+    std::vector<long long> tuberiasDisponibles(numeroCentrosAgua, 0);
+    std::vector<long long> minutosTuberias(numeroCentrosAgua, 0);
+    for (int u = 0; u < numeroCentrosAgua; ++u) {
+        candidatos[u] = u;
+        for (int tuberia = red.inicioAdyacentes[u]; tuberia < red.inicioAdyacentes[u + 1]; ++tuberia) {
+            if (red.disponibles[tuberia]) {
+                tuberiasDisponibles[u]++;
+                minutosTuberias[u] += red.minutos[tuberia];
+            }
+        }
+        for (int posicion = inversa.inicioEntrantes[u]; posicion < inversa.inicioEntrantes[u + 1]; ++posicion) {
+            if (red.disponibles[inversa.tuberias[posicion]]) {
+                tuberiasDisponibles[u]++;
+                minutosTuberias[u] += red.minutos[inversa.tuberias[posicion]];
+            }
+        }
+    }
+    std::sort(candidatos.begin(), candidatos.end(), [&](int a, int b) {
+        if (tuberiasDisponibles[a] != tuberiasDisponibles[b]) {
+            return tuberiasDisponibles[a] > tuberiasDisponibles[b];
+        }
+        if (minutosTuberias[a] != minutosTuberias[b]) {
+            return minutosTuberias[a] < minutosTuberias[b];
+        }
+        return a < b;
+    });
+
+    // Mejor origen compartido entre los hilos
+    std::mutex cerrojoMejor;
+    int mejorOrigen = -1;
+    ResumenOrigen mejorResumen;
+    std::vector<int> mejoresMinutos(numeroCentrosAgua);
+    std::vector<int> mejorPrevio(numeroCentrosAgua);
+    std::atomic<int> siguienteCandidato(0);
+    std::atomic<int> descartados(0);
+    std::atomic<int> podadas(0);
+    std::atomic<long long> asentadosTotales(0);
+
+    std::vector<EspacioDijkstra> espacios;
+    espacios.reserve(pool.getNumeroHilos());
+    for (int hilo = 0; hilo < pool.getNumeroHilos(); ++hilo) {
+        espacios.emplace_back(numeroCentrosAgua, G.getMinutosMaximo());
+    }
+
+    // Cada tarea toma el siguiente candidato del orden heurístico, sin importar el índice que le asignó el pool
+    pool.paraCada(numeroCentrosAgua, [&](int hilo, int) {
+        int origen = candidatos[siguienteCandidato.fetch_add(1)];
+
+        // Copia local del mejor; la cota solo puede mejorar mientras se busca, así que usarla es siempre correcto
+        int origenCota;
+        ResumenOrigen cota;
+        bool podable;
+        {
+            std::lock_guard<std::mutex> guardia(cerrojoMejor);
+            origenCota = mejorOrigen;
+            cota = mejorResumen;
+            podable = mejorOrigen != -1 && (mejorResumen.centrosInalcanzables == 0 || mejoresMinutos[origen] != INT_MAX);
+        }
+        // Dentro del alcance del mejor, el candidato no puede alcanzar más centros; si solo importan los alcanzados,
+        // a lo sumo empata y el empate lo gana el índice menor
+        if (podable && objetivo == ObjetivoAlcanzables && origen > origenCota) {
+            descartados++;
+            return;
+        }
+
+        EspacioDijkstra& espacio = espacios[hilo];
+        long long alcanzadosCota = podable ? numeroCentrosAgua - cota.centrosInalcanzables : 0;
+        long long asentados = 0;
+        long long minutosAsentados = 0;
+        bool podada = false;
+        ResumenOrigen resumen;
+        resumen.relajaciones = espacio.ejecutar(red, origen, [&](int, int minutos) {
+            asentados++;
+            minutosAsentados += minutos;
+            if (!podable || objetivo == ObjetivoAlcanzables) {
+                return true;
+            }
+            bool pierde;
+            if (objetivo == ObjetivoMinutosMaximo) {
+                pierde = minutos > cota.minutosMaximo;
+            } else {
+                long long minimoTotal = minutosAsentados + std::max(0LL, alcanzadosCota - asentados) * minutos;
+                pierde = minimoTotal > cota.minutosTotales || (minimoTotal == cota.minutosTotales && origen > origenCota);
+            }
+            podada = pierde;
+            return !pierde;
+        });
+        asentadosTotales += asentados;
+        if (podada) {
+            podadas++;
+            return;
+        }
+
+        const std::vector<int>& alcanzados = espacio.getAsentados();
+        resumen.minutosTotales = minutosAsentados;
+        resumen.minutosMaximo = espacio.getMinutos(alcanzados.back()); // Los asentados salen en orden creciente
+        resumen.centrosInalcanzables = numeroCentrosAgua - static_cast<int>(alcanzados.size());
+
+        std::lock_guard<std::mutex> guardia(cerrojoMejor);
+        if (mejorOrigen == -1 || esMejorOrigenSegun(objetivo, resumen, origen, mejorResumen, mejorOrigen)) {
+            mejorOrigen = origen;
+            mejorResumen = resumen;
+            espacio.copiarResultado(mejoresMinutos, mejorPrevio); // Memoria ya reservada: no pide memoria bajo el cerrojo
+        }
+    });
+
+    resultado.origenOptimo = mejorOrigen;
+    resultado.resumen = mejorResumen;
+    resultado.minutosOrigenOptimo.swap(mejoresMinutos);
+    resultado.previoOrigenOptimo.swap(mejorPrevio);
+    resultado.candidatosDescartados = descartados;
+    resultado.busquedasPodadas = podadas;
+    resultado.centrosAsentados = asentadosTotales;
+    return resultado;
+}
+
+#endif // ORIGEN_OPTIMO_H
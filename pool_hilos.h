@@ -0,0 +1,172 @@
+#ifndef POOL_HILOS_H
+#define POOL_HILOS_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <algorithm>
+
+/**
+ * Clase PoolHilos
+ *
+ * Conjunto de hilos de trabajo persistentes que reparten un rango de tareas [0, numeroTareas) con robo de trabajo.
+ * Cada hilo recibe al comienzo un bloque contiguo de tareas y las consume desde el inicio de su bloque; cuando se
+ * queda sin tareas roba la mitad final del bloque de otro hilo. Así las búsquedas que tardan más (por ejemplo
+ * orígenes con muchos centros alcanzables) no dejan hilos ociosos al final del cálculo.
+ */
+class PoolHilos {
+    private:
+        // Bloque de tareas pendientes de un hilo, protegido por su propio cerrojo
+        struct BloqueTareas {
+            std::mutex cerrojo;
+            int inicio = 0;
+            int fin = 0;
+        };
+
+        std::vector<std::thread> hilos; // Hilos de trabajo
+        std::vector<std::unique_ptr<BloqueTareas>> bloques; // Bloque de tareas de cada hilo
+        std::function<void(int, int)> tarea; // Tarea actual: recibe el índice del hilo y el índice de la tarea
+        std::mutex cerrojo; // Protege generacion, hilosActivos y detener
+        std::condition_variable hayTrabajo; // Avisa a los hilos de que hay un nuevo lote de tareas
+        std::condition_variable trabajoTerminado; // Avisa al llamador de que todos los hilos terminaron
+        int generacion = 0; // Número de lotes de tareas lanzados
+        int hilosActivos = 0; // Hilos que aún trabajan en el lote actual
+        bool detener = false; // Indica a los hilos que deben terminar
+
+        /**
+         * Toma la siguiente tarea del bloque propio del hilo.
+         */
+        bool tomarPropia(int hilo, int& indice) {
+            BloqueTareas& bloque = *bloques[hilo];
+            std::lock_guard<std::mutex> guardia(bloque.cerrojo);
+            if (bloque.inicio < bloque.fin) {
+                indice = bloque.inicio++;
+                return true;
+            }
+            return false;
+        }
+
+        /**
+         * Roba la mitad final del bloque de otro hilo; la primera tarea robada se devuelve en indice y el resto
+         * pasa a ser el bloque propio del hilo.
+         */
+        bool robar(int hilo, int& indice) {
+            int numeroHilos = static_cast<int>(bloques.size());
+            for (int desplazamiento = 1; desplazamiento < numeroHilos; ++desplazamiento) {
+                BloqueTareas& victima = *bloques[(hilo + desplazamiento) % numeroHilos];
+                int inicioRobado, finRobado;
+                {
+                    std::lock_guard<std::mutex> guardia(victima.cerrojo);
+                    int pendientes = victima.fin - victima.inicio;
+                    if (pendientes <= 0) {
+                        continue;
+                    }
+                    finRobado = victima.fin;
+                    inicioRobado = victima.fin - (pendientes + 1) / 2;
+                    victima.fin = inicioRobado;
+                }
+                BloqueTareas& propio = *bloques[hilo];
+                std::lock_guard<std::mutex> guardia(propio.cerrojo);
+                propio.inicio = inicioRobado + 1;
+                propio.fin = finRobado;
+                indice = inicioRobado;
+                return true;
+            }
+            return false;
+        }
+
+        /**
+         * Bucle de cada hilo: espera un lote, consume y roba tareas hasta que no quede ninguna y avisa al terminar.
+         */
+        void trabajar(int hilo) {
+            int generacionVista = 0;
+            while (true) {
+                {
+                    std::unique_lock<std::mutex> guardia(cerrojo);
+                    hayTrabajo.wait(guardia, [&] { return detener || generacion != generacionVista; });
+                    if (detener) {
+                        return;
+                    }
+                    generacionVista = generacion;
+                }
+
+                int indice;
+                while (tomarPropia(hilo, indice) || robar(hilo, indice)) {
+                    tarea(hilo, indice);
+                }
+
+                std::lock_guard<std::mutex> guardia(cerrojo);
+                if (--hilosActivos == 0) {
+                    trabajoTerminado.notify_all();
+                }
+            }
+        }
+
+    public:
+        /**
+         * Constructor de la clase PoolHilos.
+         *
+         * @param numeroHilos Cantidad de hilos de trabajo; 0 usa la cantidad de núcleos disponibles.
+         */
+        explicit PoolHilos(int numeroHilos = 0) {
+            if (numeroHilos <= 0) {
+                numeroHilos = std::max(1u, std::thread::hardware_concurrency());
+            }
+            for (int hilo = 0; hilo < numeroHilos; ++hilo) {
+                bloques.push_back(std::make_unique<BloqueTareas>());
+            }
+            for (int hilo = 0; hilo < numeroHilos; ++hilo) {
+                hilos.emplace_back(&PoolHilos::trabajar, this, hilo);
+            }
+        }
+
+        PoolHilos(const PoolHilos&) = delete;
+        PoolHilos& operator=(const PoolHilos&) = delete;
+
+        ~PoolHilos() {
+            {
+                std::lock_guard<std::mutex> guardia(cerrojo);
+                detener = true;
+            }
+            hayTrabajo.notify_all();
+            for (std::thread& hilo : hilos) {
+                hilo.join();
+            }
+        }
+
+        /**
+         * Obtiene la cantidad de hilos de trabajo.
+         *
+         * @return Número de hilos.
+         */
+        int getNumeroHilos() const {
+            return static_cast<int>(hilos.size());
+        }
+
+        /**
+         * Ejecuta funcion(hilo, indice) para cada índice en [0, numeroTareas) y espera a que terminen todas.
+         * El índice del hilo está en [0, getNumeroHilos()) y permite a cada tarea usar buffers propios del hilo.
+         *
+         * @param numeroTareas Cantidad de tareas a ejecutar.
+         * @param funcion Función a ejecutar por cada tarea.
+         */
+        void paraCada(int numeroTareas, const std::function<void(int, int)>& funcion) {
+            int numeroHilos = getNumeroHilos();
+            std::unique_lock<std::mutex> guardia(cerrojo);
+            tarea = funcion;
+            for (int hilo = 0; hilo < numeroHilos; ++hilo) {
+                std::lock_guard<std::mutex> guardiaBloque(bloques[hilo]->cerrojo);
+                bloques[hilo]->inicio = static_cast<int>(static_cast<long long>(numeroTareas) * hilo / numeroHilos);
+                bloques[hilo]->fin = static_cast<int>(static_cast<long long>(numeroTareas) * (hilo + 1) / numeroHilos);
+            }
+            hilosActivos = numeroHilos;
+            ++generacion;
+            hayTrabajo.notify_all();
+            trabajoTerminado.wait(guardia, [&] { return hilosActivos == 0; });
+        }
+};
+
+#endif // POOL_HILOS_H
@@ -0,0 +1,408 @@
+#ifndef RED_VERSIONADA_H
+#define RED_VERSIONADA_H
+
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+#include <algorithm>
+#include "rutas.h"
+
+/*Red de tuberías con versiones inmutables, para responder consultas desde varios hilos mientras alguien modifica
+  tuberías (lectura-copia-actualización). Rutas se modifica en el lugar, así que ninguna búsqueda puede correr mientras
+  se agrega una tubería o se cambia su disponibilidad; aquí cada modificación arma una versión nueva de la red y la
+  publica cambiando un puntero atómico, y las versiones ya publicadas no se tocan nunca más.
+
+  Las versiones comparten todo lo que no cambió:
+   - la forma de la red (inicio de las adyacencias, destinos y minutos) se comparte entre todas las versiones que solo
+     cambiaron disponibilidades; agregar una tubería o cambiar sus minutos arma una forma nueva;
+   - la disponibilidad es un arreglo de bits en bloques de bitsBloqueDisponibilidad tuberías, cada uno compartido
+     entre versiones. Cambiar la disponibilidad de una tubería copia solo su bloque y los punteros a los bloques.
+
+  Cada lector fija la versión vigente al empezar una consulta y la usa hasta terminar, sin cerrojos: fijar es guardar
+  el puntero en la ranura del lector y comprobar que sigue vigente (un puntero de peligro). Los escritores se
+  ordenan entre sí con un cerrojo y, después de publicar, liberan las versiones reemplazadas que ningún lector tiene
+  fijadas; las que siguen fijadas se liberan en alguna publicación posterior. Los lectores se identifican por un
+  índice en [0, numeroLectores), como los hilos de PoolHilos, y cada uno fija a lo sumo una versión a la vez. */
+
+const int bitsBloqueDisponibilidad = 4096; // Tuberías por bloque de disponibilidad (potencia de dos)
+
+/**
+ * Estructura BloqueDisponibilidad
+ *
+ * Disponibilidad de bitsBloqueDisponibilidad tuberías consecutivas, un bit por tubería.
+ */
+struct BloqueDisponibilidad {
+    uint64_t palabras[bitsBloqueDisponibilidad / 64] = {}; // Bit t % 64 de la palabra t / 64: tubería t del bloque
+};
+
+/**
+ * Estructura DisponibilidadVersionada
+ *
+ * Disponibilidad de las tuberías de una versión: se indexa igual que RedCSR::disponibles. Los bloques son inmutables
+ * y pueden estar compartidos con otras versiones.
+ */
+struct DisponibilidadVersionada {
+    std::vector<std::shared_ptr<const BloqueDisponibilidad>> bloques; // Bloque de cada tramo de tuberías
+
+    char operator[](int tuberia) const {
+        const BloqueDisponibilidad& bloque = *bloques[tuberia / bitsBloqueDisponibilidad];
+        int bit = tuberia % bitsBloqueDisponibilidad;
+        return static_cast<char>((bloque.palabras[bit / 64] >> (bit % 64)) & 1);
+    }
+
+    /**
+     * Arma la disponibilidad desde un arreglo como RedCSR::disponibles, con bloques nuevos.
+     */
+    static DisponibilidadVersionada desdeArreglo(const std::vector<char>& disponibles) {
+        DisponibilidadVersionada disponibilidad;
+        int numeroTuberias = static_cast<int>(disponibles.size());
+        for (int inicio = 0; inicio < numeroTuberias; inicio += bitsBloqueDisponibilidad) {
+            std::shared_ptr<BloqueDisponibilidad> bloque = std::make_shared<BloqueDisponibilidad>();
+            int fin = std::min(inicio + bitsBloqueDisponibilidad, numeroTuberias);
+            for (int tuberia = inicio; tuberia < fin; ++tuberia) {
+                if (disponibles[tuberia]) {
+                    int bit = tuberia - inicio;
+                    bloque->palabras[bit / 64] |= uint64_t(1) << (bit % 64);
+                }
+            }
+            disponibilidad.bloques.push_back(std::move(bloque));
+        }
+        return disponibilidad;
+    }
+
+    /**
+     * Copia la disponibilidad con una tubería cambiada: comparte todos los bloques menos el de esa tubería.
+     */
+    DisponibilidadVersionada conTuberia(int tuberia, bool disponible) const {
+        DisponibilidadVersionada cambiada = *this;
+        std::shared_ptr<BloqueDisponibilidad> bloque = std::make_shared<BloqueDisponibilidad>(*bloques[tuberia / bitsBloqueDisponibilidad]);
+        int bit = tuberia % bitsBloqueDisponibilidad;
+        if (disponible) {
+            bloque->palabras[bit / 64] |= uint64_t(1) << (bit % 64);
+        } else {
+            bloque->palabras[bit / 64] &= ~(uint64_t(1) << (bit % 64));
+        }
+        cambiada.bloques[tuberia / bitsBloqueDisponibilidad] = std::move(bloque);
+        return cambiada;
+    }
+};
+
+/**
+ * Estructura VersionRed
+ *
+ * Versión inmutable de la red. Tiene los mismos arreglos indexables que RedCSR, así que sirve para
+ * EspacioDijkstra::ejecutar y para cualquier búsqueda que lea la red por plantilla.
+ */
+struct VersionRed {
+    std::shared_ptr<const RedCSR> forma; // Adyacencias y minutos, compartidos entre versiones (sus disponibles quedan vacíos)
+    unsigned long long numero; // Modificaciones desde la red inicial, como Rutas::getVersion
+    int minutosMaximo; // Minutos de la tubería más lenta, para elegir la cola de Dijkstra (ver Rutas::getMinutosMaximo)
+    const std::vector<int>& inicioAdyacentes; // Los de la forma
+    const std::vector<int>& destinos; // Los de la forma
+    const std::vector<int>& minutos; // Los de la forma
+    DisponibilidadVersionada disponibles; // Disponibilidad de esta versión
+
+    VersionRed(std::shared_ptr<const RedCSR> forma, DisponibilidadVersionada disponibles, unsigned long long numero, int minutosMaximo)
+        : forma(std::move(forma)), numero(numero), minutosMaximo(minutosMaximo), inicioAdyacentes(this->forma->inicioAdyacentes),
+          destinos(this->forma->destinos), minutos(this->forma->minutos), disponibles(std::move(disponibles)) {}
+
+    VersionRed(const VersionRed&) = delete;
+    VersionRed& operator=(const VersionRed&) = delete;
+
+    /**
+     * Obtiene el número de centros de agua de la versión.
+     */
+    int getNumeroCentrosAgua() const {
+        return static_cast<int>(inicioAdyacentes.size()) - 1;
+    }
+
+    /**
+     * Busca la posición de la tubería u -> v, como RedCSR::buscarTuberia.
+     */
+    int buscarTuberia(int u, int v) const {
+        return forma->buscarTuberia(u, v);
+    }
+
+    /**
+     * Copia la versión a una instantánea CSR independiente, por ejemplo para armar una Rutas con ella.
+     */
+    RedCSR copiarRedCSR() const {
+        RedCSR red;
+        red.inicioAdyacentes = inicioAdyacentes;
+        red.destinos = destinos;
+        red.minutos = minutos;
+        red.disponibles.resize(destinos.size());
+        for (size_t tuberia = 0; tuberia < destinos.size(); ++tuberia) {
+            red.disponibles[tuberia] = disponibles[static_cast<int>(tuberia)];
+        }
+        return red;
+    }
+};
+
+/**
+ * Clase RedVersionada
+ *
+ * Red de tuberías que publica una versión inmutable por cada modificación. Las consultas fijan una versión (ver
+ * LecturaRed) y pueden correr en cualquier hilo mientras otro modifica la red.
+ */
+class RedVersionada {
+    private:
+        // Versión fijada por un lector, en su propia línea de caché para que los lectores no se estorben
+        struct alignas(64) RanuraLector {
+            std::atomic<const VersionRed*> version{nullptr};
+        };
+
+        int numeroLectores; // Cantidad de ranuras de lectores
+        std::unique_ptr<RanuraLector[]> ranuras; // Versión fijada por cada lector (nullptr si ninguna)
+        std::atomic<const VersionRed*> vigente; // Versión que reciben los lectores al fijar
+        std::atomic<unsigned long long> numeroVigente; // Número de la versión vigente, legible sin fijarla
+        std::mutex cerrojoEscritura; // Ordena a los escritores; los lectores no lo usan
+        std::vector<const VersionRed*> retiradas; // Versiones reemplazadas que algún lector podía tener fijadas
+        bool mostrarMensajes = true; // Indica si las modificaciones se informan por consola, como en Rutas
+
+        /**
+         * Publica una versión nueva y libera las reemplazadas que ya nadie tiene fijadas. Requiere cerrojoEscritura.
+         */
+        void publicar(const VersionRed* nueva) {
+            retiradas.push_back(vigente.exchange(nueva));
+            numeroVigente.store(nueva->numero);
+            liberarRetiradas();
+        }
+
+        /**
+         * Libera las versiones retiradas que no están en ninguna ranura. Un lector que guardó una de ellas en su ranura
+         * después de esta revisión ve, al comprobarla, que ya no es la vigente y la suelta sin usarla. Requiere
+         * cerrojoEscritura.
+         */
+        void liberarRetiradas() {
+            std::vector<const VersionRed*> fijadas;
+            for (int lector = 0; lector < numeroLectores; ++lector) {
+                const VersionRed* version = ranuras[lector].version.load();
+                if (version != nullptr) {
+                    fijadas.push_back(version);
+                }
+            }
+            std::sort(fijadas.begin(), fijadas.end());
+            auto siguenFijadas = std::partition(retiradas.begin(), retiradas.end(), [&](const VersionRed* version) {
+                return std::binary_search(fijadas.begin(), fijadas.end(), version);
+            });
+            for (auto it = siguenFijadas; it != retiradas.end(); ++it) {
+                delete *it;
+            }
+            retiradas.erase(siguenFijadas, retiradas.end());
+        }
+
+    public:
+        /**
+         * Constructor de la clase RedVersionada.
+         *
+         * @param G Red inicial; se copia su instantánea y su versión, así que G puede seguir usándose por separado.
+         * @param numeroLectores Cantidad de lectores que pueden tener una versión fijada a la vez (por ejemplo los
+         *                       hilos del pool que responden consultas).
+         */
+        RedVersionada(Rutas& G, int numeroLectores)
+            : numeroLectores(numeroLectores), ranuras(new RanuraLector[numeroLectores]) {
+            const RedCSR& red = G.getRedCSR();
+            std::shared_ptr<RedCSR> forma = std::make_shared<RedCSR>();
+            forma->inicioAdyacentes = red.inicioAdyacentes;
+            forma->destinos = red.destinos;
+            forma->minutos = red.minutos;
+            const VersionRed* inicial = new VersionRed(std::move(forma), DisponibilidadVersionada::desdeArreglo(red.disponibles),
+                                                       G.getVersion(), G.getMinutosMaximo());
+            vigente.store(inicial);
+            numeroVigente.store(inicial->numero);
+        }
+
+        RedVersionada(const RedVersionada&) = delete;
+        RedVersionada& operator=(const RedVersionada&) = delete;
+
+        /**
+         * Destructor: libera todas las versiones. Ningún lector debe tener una versión fijada.
+         */
+        ~RedVersionada() {
+            delete vigente.load();
+            for (const VersionRed* version : retiradas) {
+                delete version;
+            }
+        }
+
+        /**
+         * Fija la versión vigente para un lector: no se liberará hasta que el lector la suelte. No usa cerrojos.
+         *
+         * @param lector Índice del lector en [0, numeroLectores); no debe tener otra versión fijada.
+         * @return Versión fijada, válida hasta llamar a soltar con el mismo lector.
+         */
+        const VersionRed* fijar(int lector) {
+            std::atomic<const VersionRed*>& ranura = ranuras[lector].version;
+            const VersionRed* version = vigente.load();
+            while (true) {
+                ranura.store(version);
+                // Si sigue vigente después de anunciarla, ningún escritor que la retire puede liberarla: al revisar
+                // las ranuras la encontrará
+                const VersionRed* comprobada = vigente.load();
+                if (comprobada == version) {
+                    return version;
+                }
+                version = comprobada;
+            }
+        }
+
+        /**
+         * Suelta la versión fijada por un lector. La memoria se libera en la siguiente publicación de un escritor.
+         *
+         * @param lector Índice del lector.
+         */
+        void soltar(int lector) {
+            ranuras[lector].version.store(nullptr, std::memory_order_release);
+        }
+
+        /**
+         * Obtiene el número de la versión vigente, que aumenta con cada modificación como Rutas::getVersion.
+         */
+        unsigned long long getVersion() const {
+            return numeroVigente.load();
+        }
+
+        /**
+         * Obtiene la cantidad de lectores que pueden tener una versión fijada a la vez.
+         */
+        int getNumeroLectores() const {
+            return numeroLectores;
+        }
+
+        /**
+         * Obtiene la cantidad de versiones reemplazadas que siguen en memoria porque algún lector las tenía fijadas.
+         */
+        int getVersionesRetenidas() {
+            std::lock_guard<std::mutex> guardia(cerrojoEscritura);
+            return static_cast<int>(retiradas.size());
+        }
+
+        /**
+         * Libera las versiones reemplazadas que ya nadie tiene fijadas, sin esperar a la siguiente publicación.
+         */
+        void liberarVersionesRetenidas() {
+            std::lock_guard<std::mutex> guardia(cerrojoEscritura);
+            liberarRetiradas();
+        }
+
+        /**
+         * Activa o desactiva los mensajes por consola de las modificaciones de tuberías.
+         *
+         * @param mostrar Verdadero para informar cada modificación.
+         */
+        void setMostrarMensajes(bool mostrar) {
+            mostrarMensajes = mostrar;
+        }
+
+        /**
+         * Establece la disponibilidad de una tubería existente y publica la versión resultante. La nueva versión
+         * comparte la forma de la red y todos los bloques de disponibilidad menos uno.
+         *
+         * @param u Índice del centro de agua de origen.
+         * @param v Índice del centro de agua de destino.
+         * @param disponibilidad Nuevo estado de disponibilidad para la tubería.
+         * @return false si la tubería no existe (no se publica nada).
+         */
+        bool establecerDisponibilidad(int u, int v, bool disponibilidad) {
+            std::lock_guard<std::mutex> guardia(cerrojoEscritura);
+            const VersionRed* actual = vigente.load(std::memory_order_relaxed); // Solo los escritores la cambian
+            int tuberia = actual->buscarTuberia(u, v);
+            if (tuberia != -1) {
+                publicar(new VersionRed(actual->forma, actual->disponibles.conTuberia(tuberia, disponibilidad), actual->numero + 1,
+                                        actual->minutosMaximo));
+            }
+            if (mostrarMensajes && tuberia != -1) {
+                std::cout << "Tubería " << u << " a " << v << " modificada." << std::endl;
+            } else if (mostrarMensajes) {
+                std::cout << "La tuberia de " << u << " a " << v << " no existe." << std::endl;
+            }
+            return tuberia != -1;
+        }
+
+        /**
+         * Agrega o actualiza una tubería y publica la versión resultante. Cambia la forma de la red, así que la nueva
+         * versión no comparte nada con la anterior: cuesta lo mismo que copiar la red.
+         *
+         * @param u Índice del centro de agua de origen.
+         * @param v Índice del centro de agua de destino.
+         * @param tiempoParaLlegar Tiempo de viaje a través de la tubería.
+         * @param disponibilidad Estado de disponibilidad de la tubería.
+         */
+        void agregarTuberia(int u, int v, int tiempoParaLlegar, bool disponibilidad = true) {
+            std::lock_guard<std::mutex> guardia(cerrojoEscritura);
+            const VersionRed* actual = vigente.load(std::memory_order_relaxed);
+            std::shared_ptr<RedCSR> forma = std::make_shared<RedCSR>();
+            forma->inicioAdyacentes = actual->inicioAdyacentes;
+            forma->destinos = actual->destinos;
+            forma->minutos = actual->minutos;
+            std::vector<char> disponibles(actual->destinos.size());
+            for (size_t tuberia = 0; tuberia < disponibles.size(); ++tuberia) {
+                disponibles[tuberia] = actual->disponibles[static_cast<int>(tuberia)];
+            }
+
+            int tuberia = actual->buscarTuberia(u, v);
+            if (tuberia == -1) {
+                // Los destinos de cada centro están ordenados: la tubería nueva va en su lugar y las siguientes se corren
+                auto inicio = forma->destinos.begin() + forma->inicioAdyacentes[u];
+                auto fin = forma->destinos.begin() + forma->inicioAdyacentes[u + 1];
+                tuberia = static_cast<int>(std::lower_bound(inicio, fin, v) - forma->destinos.begin());
+                forma->destinos.insert(forma->destinos.begin() + tuberia, v);
+                forma->minutos.insert(forma->minutos.begin() + tuberia, tiempoParaLlegar);
+                disponibles.insert(disponibles.begin() + tuberia, 0);
+                for (size_t centro = u + 1; centro < forma->inicioAdyacentes.size(); ++centro) {
+                    forma->inicioAdyacentes[centro]++;
+                }
+            }
+            forma->minutos[tuberia] = tiempoParaLlegar;
+            disponibles[tuberia] = disponibilidad ? 1 : 0;
+            int minutosMaximo = calcularMinutosMaximo(*forma);
+            publicar(new VersionRed(std::move(forma), DisponibilidadVersionada::desdeArreglo(disponibles), actual->numero + 1,
+                                    minutosMaximo));
+        }
+};
+
+/**
+ * Clase LecturaRed
+ *
+ * Versión fijada durante el alcance de un objeto: se fija al crearlo y se suelta al destruirlo.
+ *
+ * Uso típico desde un hilo del pool:
+ *     LecturaRed lectura(red, hilo);
+ *     espacios[hilo].ejecutar(*lectura, origen);
+ */
+class LecturaRed {
+    private:
+        RedVersionada& red; // Red de la que se fijó la versión
+        int lector; // Ranura del lector
+        const VersionRed* version; // Versión fijada
+
+    public:
+        /**
+         * Constructor de la clase LecturaRed.
+         *
+         * @param red Red versionada.
+         * @param lector Índice del lector en [0, red.getNumeroLectores()), sin otra versión fijada.
+         */
+        LecturaRed(RedVersionada& red, int lector) : red(red), lector(lector), version(red.fijar(lector)) {}
+
+        LecturaRed(const LecturaRed&) = delete;
+        LecturaRed& operator=(const LecturaRed&) = delete;
+
+        ~LecturaRed() {
+            red.soltar(lector);
+        }
+
+        const VersionRed& operator*() const {
+            return *version;
+        }
+
+        const VersionRed* operator->() const {
+            return version;
+        }
+};
+
+#endif // RED_VERSIONADA_H
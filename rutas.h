@@ -0,0 +1,508 @@
+#ifndef RUTAS_H
+#define RUTAS_H
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <deque>
+#include <algorithm>
+#include <utility>
+#include "tipos_red.h"
+#include "instrumentacion.h"
+
+/**
+ * Estructura RedCSRCon
+ *
+ * Instantánea compacta (Compressed Sparse Row) de la red de tuberías. Las tuberías que salen del centro u
+ * ocupan las posiciones [inicioAdyacentes[u], inicioAdyacentes[u + 1]) de los arreglos destinos, minutos y
+ * disponibles, ordenadas por centro destino. Así Dijkstra recorre los vecinos de un centro con un barrido lineal
+ * sobre memoria contigua en lugar de consultar el mapa de tuberías por cada arista.
+ *
+ * @tparam Tipos Tipos de los centros y los minutos (ver tipos_red.h); RedCSR usa int.
+ */
+template <typename Tipos>
+struct RedCSRCon {
+    using Centro = typename Tipos::Centro;
+    using Minutos = typename Tipos::Minutos;
+
+    std::vector<int> inicioAdyacentes; // Desplazamiento de la primera tubería de cada centro (tamaño centroAgua + 1).
+    std::vector<Centro> destinos; // Centro de agua destino de cada tubería.
+    std::vector<Minutos> minutos; // Tiempo de viaje de cada tubería.
+    std::vector<char> disponibles; // Disponibilidad de cada tubería (1 disponible, 0 deshabilitada).
+
+    /**
+     * Busca la posición de la tubería u -> v dentro de la instantánea.
+     *
+     * @param u Índice del centro de agua de origen.
+     * @param v Índice del centro de agua de destino.
+     * @return La posición de la tubería en los arreglos, o -1 si no existe o u está fuera de rango.
+     */
+    int buscarTuberia(Centro u, Centro v) const {
+        long long origen = static_cast<long long>(u);
+        if (origen < 0 || origen + 1 >= static_cast<long long>(inicioAdyacentes.size())) {
+            return -1;
+        }
+        auto inicio = destinos.begin() + inicioAdyacentes[u];
+        auto fin = destinos.begin() + inicioAdyacentes[u + 1];
+        auto it = std::lower_bound(inicio, fin, v);
+        if (it == fin || *it != v) {
+            return -1;
+        }
+        return static_cast<int>(it - destinos.begin());
+    }
+};
+
+using RedCSR = RedCSRCon<TiposRedPredeterminados>; // Instantánea con centros y minutos int
+
+/**
+ * Estructura TuberiaLeida
+ *
+ * Tubería leída de un archivo o de una lista externa, antes de armar la red.
+ */
+struct TuberiaLeida {
+    int u; // Centro de agua de origen
+    int v; // Centro de agua de destino
+    int minutos; // Tiempo de viaje
+    bool disponible; // Disponibilidad de la tubería
+};
+
+/**
+ * Construye una instantánea CSR directamente desde una lista de tuberías, sin pasar por el mapa de Rutas.
+ * Las tuberías se ordenan por (u, v); si una tubería aparece repetida gana la última, igual que en agregarTuberia.
+ *
+ * @param numeroCentrosAgua Número de centros de agua; todos los índices deben estar en [0, numeroCentrosAgua).
+ * @param tuberias Lista de tuberías (se reordena).
+ * @return La instantánea compacta de la red.
+ */
+RedCSR construirRedCSR(int numeroCentrosAgua, std::vector<TuberiaLeida>& tuberias) {
+    std::stable_sort(tuberias.begin(), tuberias.end(), [](const TuberiaLeida& a, const TuberiaLeida& b) {
+        return a.u != b.u ? a.u < b.u : a.v < b.v;
+    });
+
+    RedCSR red;
+    red.inicioAdyacentes.assign(numeroCentrosAgua + 1, 0);
+    red.destinos.reserve(tuberias.size());
+    red.minutos.reserve(tuberias.size());
+    red.disponibles.reserve(tuberias.size());
+    for (size_t i = 0; i < tuberias.size(); ++i) {
+        if (i + 1 < tuberias.size() && tuberias[i + 1].u == tuberias[i].u && tuberias[i + 1].v == tuberias[i].v) {
+            continue; // Una tubería posterior con los mismos extremos la reemplaza
+        }
+        red.inicioAdyacentes[tuberias[i].u + 1]++;
+        red.destinos.push_back(tuberias[i].v);
+        red.minutos.push_back(tuberias[i].minutos);
+        red.disponibles.push_back(tuberias[i].disponible ? 1 : 0);
+    }
+    for (int u = 0; u < numeroCentrosAgua; ++u) {
+        red.inicioAdyacentes[u + 1] += red.inicioAdyacentes[u];
+    }
+    return red;
+}
+
+/**
+ * Calcula los minutos de la tubería más lenta de una instantánea.
+ *
+ * @param red Instantánea compacta de la red.
+ * @return Mayor tiempo de viaje de una tubería (0 si no hay tuberías).
+ */
+template <typename Tipos>
+typename Tipos::Minutos calcularMinutosMaximo(const RedCSRCon<Tipos>& red) {
+    return red.minutos.empty() ? 0 : *std::max_element(red.minutos.begin(), red.minutos.end());
+}
+
+/**
+ * Copia una instantánea a otros tipos de centros y minutos (por ejemplo de int a TiposRedPequenos).
+ *
+ * @param red Instantánea de origen.
+ * @param convertida Instantánea donde se escribe la copia.
+ * @return false si algún centro o algunos minutos no caben en los nuevos tipos (convertida queda sin usar).
+ */
+template <typename TiposDestino, typename TiposOrigen>
+bool convertirRedCSR(const RedCSRCon<TiposOrigen>& red, RedCSRCon<TiposDestino>& convertida) {
+    using Centro = typename TiposDestino::Centro;
+    using Minutos = typename TiposDestino::Minutos;
+    unsigned long long mayorIndice = static_cast<unsigned long long>(std::numeric_limits<Centro>::max());
+    if (std::is_unsigned<Centro>::value) {
+        mayorIndice--; // El mayor valor sin signo es el centinela sinCentro
+    }
+    if (red.inicioAdyacentes.size() > 1 && red.inicioAdyacentes.size() - 2 > mayorIndice) {
+        return false;
+    }
+    for (auto minutos : red.minutos) {
+        if (minutos < 0 || static_cast<unsigned long long>(minutos) > static_cast<unsigned long long>(std::numeric_limits<Minutos>::max())) {
+            return false;
+        }
+    }
+    convertida.inicioAdyacentes = red.inicioAdyacentes;
+    convertida.destinos.assign(red.destinos.begin(), red.destinos.end());
+    convertida.minutos.assign(red.minutos.begin(), red.minutos.end());
+    convertida.disponibles = red.disponibles;
+    return true;
+}
+
+/**
+ * Estructura RedInversaCSRCon
+ *
+ * Tuberías agrupadas por centro de agua destino. Las tuberías que llegan al centro v ocupan las posiciones
+ * [inicioEntrantes[v], inicioEntrantes[v + 1]) de los arreglos origenes y tuberias; tuberias guarda la posición de
+ * cada una en RedCSR, de modo que los minutos y la disponibilidad se leen siempre de la instantánea directa.
+ */
+template <typename Tipos>
+struct RedInversaCSRCon {
+    std::vector<int> inicioEntrantes; // Desplazamiento de la primera tubería entrante de cada centro (tamaño centroAgua + 1).
+    std::vector<typename Tipos::Centro> origenes; // Centro de agua de origen de cada tubería entrante.
+    std::vector<int> tuberias; // Posición de la tubería en RedCSR.
+};
+
+using RedInversaCSR = RedInversaCSRCon<TiposRedPredeterminados>; // Red inversa con centros int
+
+/**
+ * Construye la red inversa a partir de la instantánea CSR con un conteo por destino.
+ *
+ * @param red Instantánea compacta de la red.
+ * @return Tuberías agrupadas por centro de agua destino.
+ */
+template <typename Tipos>
+RedInversaCSRCon<Tipos> construirRedInversa(const RedCSRCon<Tipos>& red) {
+    int numeroCentrosAgua = static_cast<int>(red.inicioAdyacentes.size()) - 1;
+    int numeroTuberias = static_cast<int>(red.destinos.size());
+    RedInversaCSRCon<Tipos> inversa;
+    inversa.inicioEntrantes.assign(numeroCentrosAgua + 1, 0);
+    inversa.origenes.resize(numeroTuberias);
+    inversa.tuberias.resize(numeroTuberias);
+
+    for (int tuberia = 0; tuberia < numeroTuberias; ++tuberia) {
+        inversa.inicioEntrantes[red.destinos[tuberia] + 1]++;
+    }
+    for (int v = 0; v < numeroCentrosAgua; ++v) {
+        inversa.inicioEntrantes[v + 1] += inversa.inicioEntrantes[v];
+    }
+    std::vector<int> siguiente(inversa.inicioEntrantes.begin(), inversa.inicioEntrantes.end() - 1);
+    for (int u = 0; u < numeroCentrosAgua; ++u) {
+        for (int tuberia = red.inicioAdyacentes[u]; tuberia < red.inicioAdyacentes[u + 1]; ++tuberia) {
+            int posicion = siguiente[red.destinos[tuberia]]++;
+            inversa.origenes[posicion] = static_cast<typename Tipos::Centro>(u);
+            inversa.tuberias[posicion] = tuberia;
+        }
+    }
+    return inversa;
+}
+
+/**
+ * Estructura CambioTuberiaCon
+ *
+ * Modificación de una tubería registrada por Rutas: su estado antes y después del cambio. Permite a quien guardó un
+ * cálculo sobre una versión anterior decidir si el cambio lo afecta sin volver a calcularlo.
+ */
+template <typename Tipos>
+struct CambioTuberiaCon {
+    unsigned long long version; // Versión de la red después del cambio
+    typename Tipos::Centro u; // Centro de agua de origen
+    typename Tipos::Centro v; // Centro de agua de destino
+    typename Tipos::Minutos minutosAntes; // Minutos antes del cambio (sin sentido si la tubería no existía)
+    bool disponibleAntes; // Disponibilidad antes del cambio (falso si la tubería no existía)
+    typename Tipos::Minutos minutos; // Minutos después del cambio
+    bool disponible; // Disponibilidad después del cambio
+};
+
+using CambioTuberia = CambioTuberiaCon<TiposRedPredeterminados>; // Cambio con centros y minutos int
+
+const size_t limiteRegistroCambios = 4096; // Cambios recientes que recuerda cada red
+
+/**
+ * Clase RutasCon
+ * 
+ * Esta clase se utiliza para modelar y gestionar la red de tuberías de distribución de agua entre diferentes centros de agua.
+ * Permite la creación de una red de tuberías, la consulta de conexiones entre centros, y la modificación de la disponibilidad de las tuberías.
+ *
+ * @tparam Tipos Tipos de los centros y los minutos (ver tipos_red.h). Rutas, la que usan el menú y el resto de los
+ *               algoritmos, usa int; los conteos (número de centros) son siempre int.
+ */
+template <typename Tipos>
+class RutasCon {
+    public:
+        using Centro = typename Tipos::Centro;
+        using Minutos = typename Tipos::Minutos;
+
+    private:
+        int centroAgua; // Número total de centros de agua en la red.
+        std::vector<std::vector<Centro>> adyacentes; // Lista de adyacencia para representar las conexiones entre centros.
+        std::map<std::pair<Centro, Centro>, std::pair<Minutos, bool>> minutosParaLlegar; // Mapa que almacena el tiempo de viaje y la disponibilidad entre dos centros.
+        RedCSRCon<Tipos> redCSR; // Instantánea compacta de la red usada por Dijkstra.
+        bool redCSRVigente = false; // Indica si la instantánea refleja las últimas tuberías agregadas.
+        RedInversaCSRCon<Tipos> redInversaCSR; // Tuberías agrupadas por destino, usada para reparar rutas y buscar hacia atrás.
+        bool redInversaCSRVigente = false; // Indica si la red inversa corresponde a la instantánea actual.
+        bool mapaVigente = true; // Falso si la red se creó desde una instantánea y el mapa aún no se llenó.
+        bool mostrarMensajes = true; // Indica si las modificaciones se informan por consola (el modo por lotes las calla).
+        unsigned long long version = 0; // Cantidad de modificaciones de la red; permite detectar cálculos desactualizados.
+        std::deque<CambioTuberiaCon<Tipos>> registroCambios; // Últimos cambios de tuberías, del más antiguo al más reciente
+        unsigned long long versionOlvidada = 0; // Versión del último cambio que ya salió del registro
+        Minutos minutosMaximo = 0; // Minutos de la tubería más lenta de la instantánea (habilitada o no)
+
+        /**
+         * Registra un cambio de tubería, olvidando el más antiguo si el registro está lleno.
+         */
+        void registrarCambio(const CambioTuberiaCon<Tipos>& cambio) {
+            if (registroCambios.size() == limiteRegistroCambios) {
+                versionOlvidada = registroCambios.front().version;
+                registroCambios.pop_front();
+            }
+            registroCambios.push_back(cambio);
+        }
+
+        /**
+         * Llena la lista de adyacencia y el mapa de tuberías desde la instantánea, solo la primera vez que se
+         * necesitan. Así una red cargada de un archivo puede consultarse sin pagar el mapa si nunca se modifica.
+         */
+        void asegurarMapa() {
+            if (mapaVigente) {
+                return;
+            }
+            for (int u = 0; u < centroAgua; ++u) {
+                adyacentes[u].assign(redCSR.destinos.begin() + redCSR.inicioAdyacentes[u], redCSR.destinos.begin() + redCSR.inicioAdyacentes[u + 1]);
+                for (int tuberia = redCSR.inicioAdyacentes[u]; tuberia < redCSR.inicioAdyacentes[u + 1]; ++tuberia) {
+                    minutosParaLlegar.emplace_hint(minutosParaLlegar.end(), std::make_pair(static_cast<Centro>(u), redCSR.destinos[tuberia]),
+                                                   std::make_pair(redCSR.minutos[tuberia], redCSR.disponibles[tuberia] != 0));
+                }
+            }
+            mapaVigente = true;
+        }
+
+        /**
+         * Reconstruye la instantánea CSR a partir del mapa de tuberías. El mapa ya está ordenado por (u, v),
+         * por lo que basta un recorrido para contar las tuberías de cada centro y otro para llenar los arreglos.
+         */
+        void reconstruirRedCSR() {
+            redCSR.inicioAdyacentes.assign(centroAgua + 1, 0);
+            redCSR.destinos.clear();
+            redCSR.minutos.clear();
+            redCSR.disponibles.clear();
+            redCSR.destinos.reserve(minutosParaLlegar.size());
+            redCSR.minutos.reserve(minutosParaLlegar.size());
+            redCSR.disponibles.reserve(minutosParaLlegar.size());
+
+            for (const auto& [tuberia, datos] : minutosParaLlegar) {
+                redCSR.inicioAdyacentes[tuberia.first + 1]++;
+                redCSR.destinos.push_back(tuberia.second);
+                redCSR.minutos.push_back(datos.first);
+                redCSR.disponibles.push_back(datos.second ? 1 : 0);
+            }
+            for (int u = 0; u < centroAgua; ++u) {
+                redCSR.inicioAdyacentes[u + 1] += redCSR.inicioAdyacentes[u];
+            }
+            minutosMaximo = calcularMinutosMaximo(redCSR);
+            redCSRVigente = true;
+        }
+
+    public:
+        /**
+         * Constructor de la clase RutasCon.
+         * 
+         * @param centroAgua Número total de centros de agua en la red.
+         */
+        RutasCon(int centroAgua) {
+            this->centroAgua = centroAgua;
+            adyacentes = std::vector<std::vector<Centro>>(centroAgua);
+        }
+
+        /**
+         * Constructor que arma la red desde una instantánea CSR ya construida (por ejemplo leída de un archivo binario).
+         * La instantánea se adopta tal cual; el mapa de tuberías se llena recién cuando se agrega una tubería o se
+         * consulta el mapa o la lista de adyacencia.
+         * 
+         * @param red Instantánea compacta de la red.
+         */
+        explicit RutasCon(RedCSRCon<Tipos> red) {
+            centroAgua = static_cast<int>(red.inicioAdyacentes.size()) - 1;
+            adyacentes = std::vector<std::vector<Centro>>(centroAgua);
+            redCSR = std::move(red);
+            minutosMaximo = calcularMinutosMaximo(redCSR);
+            redCSRVigente = true;
+            mapaVigente = false;
+        }
+
+        /**
+         * Obtiene el número total de centros de agua en la red.
+         * 
+         * @return Número de centros de agua.
+         */
+        int getNumeroCentrosAgua() {
+            return centroAgua;
+        }
+
+        /**
+         * Obtiene la versión de la red: aumenta con cada tubería agregada y cada cambio de disponibilidad.
+         * Quien guarda un cálculo sobre la red puede comparar versiones para saber si sigue valiendo.
+         * 
+         * @return Número de modificaciones desde que se creó la red.
+         */
+        unsigned long long getVersion() const {
+            return version;
+        }
+
+        /**
+         * Indica si el registro de cambios conserva todos los cambios posteriores a una versión.
+         * 
+         * @param desdeVersion Versión de la red sobre la que se hizo un cálculo.
+         * @return Verdadero si getRegistroCambios contiene todos los cambios con versión mayor que desdeVersion.
+         */
+        bool registroCubre(unsigned long long desdeVersion) const {
+            return desdeVersion >= versionOlvidada;
+        }
+
+        /**
+         * Obtiene los últimos cambios de tuberías (a lo sumo limiteRegistroCambios), del más antiguo al más reciente.
+         * 
+         * @return Registro de cambios.
+         */
+        const std::deque<CambioTuberiaCon<Tipos>>& getRegistroCambios() const {
+            return registroCambios;
+        }
+
+        /**
+         * Obtiene la lista de centros de agua adyacentes a un centro dado.
+         * 
+         * @param numeroCentroAgua El índice del centro de agua.
+         * @return Referencia al vector de índices de centros adyacentes (válida hasta la siguiente tubería agregada).
+         */
+        const std::vector<Centro>& getAdyacentes(Centro numeroCentroAgua) {
+            asegurarMapa();
+            return adyacentes[numeroCentroAgua];
+        }
+
+        /**
+         * Obtiene el tiempo de viaje y la disponibilidad de la tubería entre dos centros de agua.
+         * 
+         * @param u Índice del centro de agua de origen.
+         * @param v Índice del centro de agua de destino.
+         * @return Par conteniendo el tiempo de viaje y la disponibilidad de la tubería, o {0, false} si no existe
+         *         (la consulta no agrega la tubería al mapa).
+         */
+        std::pair<Minutos, bool> getMinutosParaLlegarYDisponibilidad(Centro u, Centro v) const {
+            INSTRUMENTAR_FASE(FaseConsultaMapa);
+            INSTRUMENTAR_CONTAR(EventoConsultaMapa);
+            if (!mapaVigente) {
+                // Sin mapa la instantánea es la única copia de la red y está al día
+                int tuberia = redCSR.buscarTuberia(u, v);
+                return tuberia != -1 ? std::pair<Minutos, bool>(redCSR.minutos[tuberia], redCSR.disponibles[tuberia] != 0)
+                                     : std::pair<Minutos, bool>(0, false);
+            }
+            auto it = minutosParaLlegar.find({u, v});
+            return it != minutosParaLlegar.end() ? it->second : std::pair<Minutos, bool>(0, false);
+        }
+
+        /**
+         * Obtiene la instantánea CSR de la red, reconstruyéndola solo si se agregaron tuberías desde la última consulta.
+         * 
+         * @return Referencia a la instantánea compacta de la red.
+         */
+        const RedCSRCon<Tipos>& getRedCSR() {
+            if (!redCSRVigente) {
+                reconstruirRedCSR();
+            }
+            return redCSR;
+        }
+
+        /**
+         * Obtiene los minutos de la tubería más lenta de la red, habilitada o no. Dijkstra elige con este valor su
+         * cola de prioridad (ver ColaMinutos).
+         * 
+         * @return Mayor tiempo de viaje de una tubería (0 si no hay tuberías).
+         */
+        Minutos getMinutosMaximo() {
+            getRedCSR();
+            return minutosMaximo;
+        }
+
+        /**
+         * Obtiene la red inversa (tuberías entrantes de cada centro), reconstruyéndola solo si cambió la forma de la red.
+         * La disponibilidad no se copia en ella, así que establecerDisponibilidad no la invalida.
+         * 
+         * @return Referencia a la red inversa.
+         */
+        const RedInversaCSRCon<Tipos>& getRedInversaCSR() {
+            if (!redInversaCSRVigente) {
+                redInversaCSR = construirRedInversa(getRedCSR());
+                redInversaCSRVigente = true;
+            }
+            return redInversaCSR;
+        }
+
+        /**
+         * Agrega o actualiza una tubería entre dos centros de agua.
+         * 
+         * @param u Índice del centro de agua de origen.
+         * @param v Índice del centro de agua de destino.
+         * @param peso Tiempo de viaje a través de la tubería.
+         * @param disponibilidad Estado de disponibilidad de la tubería.
+         */
+        void agregarTuberia(Centro u, Centro v, Minutos tiempoParaLlegar, bool disponibilidad = true) {
+            asegurarMapa();
+            adyacentes[u].push_back(v);
+            std::pair<Minutos, bool>& tuberia = minutosParaLlegar[{u, v}]; // Una tubería nueva queda como {0, false}
+            CambioTuberiaCon<Tipos> cambio{version + 1, u, v, tuberia.first, tuberia.second, tiempoParaLlegar, disponibilidad};
+            tuberia = {tiempoParaLlegar, disponibilidad}; 
+            redCSRVigente = false; // La forma de la red cambió, la instantánea se reconstruye en la siguiente consulta
+            redInversaCSRVigente = false;
+            version++;
+            registrarCambio(cambio);
+        }
+
+        /**
+         * Activa o desactiva los mensajes por consola de las modificaciones de tuberías.
+         * 
+         * @param mostrar Verdadero para informar cada modificación.
+         */
+        void setMostrarMensajes(bool mostrar) {
+            mostrarMensajes = mostrar;
+        }
+
+        /**
+         * Establece la disponibilidad de una tubería existente entre dos centros de agua.
+         * 
+         * @param u Índice del centro de agua de origen.
+         * @param v Índice del centro de agua de destino.
+         * @param disponibilidad Nuevo estado de disponibilidad para la tubería.
+         * @return false si la tubería no existe.
+         */
+        bool establecerDisponibilidad(Centro u, Centro v, bool disponibilidad) {
+            bool existe;
+            CambioTuberiaCon<Tipos> cambio{version + 1, u, v, 0, false, 0, disponibilidad};
+            if (!mapaVigente) {
+                // Sin mapa la instantánea es la única copia de la red y se modifica directamente
+                int tuberia = redCSR.buscarTuberia(u, v);
+                existe = tuberia != -1;
+                if (existe) {
+                    cambio.minutosAntes = cambio.minutos = redCSR.minutos[tuberia];
+                    cambio.disponibleAntes = redCSR.disponibles[tuberia] != 0;
+                    redCSR.disponibles[tuberia] = disponibilidad ? 1 : 0;
+                }
+            } else {
+                auto it = minutosParaLlegar.find({u, v});
+                existe = it != minutosParaLlegar.end();
+                if (existe) {
+                    cambio.minutosAntes = cambio.minutos = it->second.first;
+                    cambio.disponibleAntes = it->second.second;
+                    it->second.second = disponibilidad;
+                    if (redCSRVigente) {
+                        redCSR.disponibles[redCSR.buscarTuberia(u, v)] = disponibilidad ? 1 : 0; // Parchar la instantánea sin reconstruirla
+                    }
+                }
+            }
+            if (existe) {
+                version++;
+                registrarCambio(cambio);
+            }
+            if (mostrarMensajes && existe) {
+                std::cout << "Tubería " << u << " a " << v << " modificada." << std::endl;
+            } else if (mostrarMensajes) {
+                std::cout << "La tuberia de " << u << " a " << v << " no existe." << std::endl;
+            }
+            return existe;
+        }
+
+};
+
+using Rutas = RutasCon<TiposRedPredeterminados>; // Red con centros y minutos int
+
+#endif // RUTAS_H
@@ -0,0 +1,316 @@
+#ifndef RUTAS_DINAMICAS_H
+#define RUTAS_DINAMICAS_H
+
+#include <vector>
+#include <map>
+#include <climits>
+#include <tuple>
+#include <utility>
+#include "rutas.h"
+#include "cola_prioridad.h"
+#include "dijkstra.h"
+
+/**
+ * Clase ArbolRutasDinamico
+ *
+ * Árbol de rutas más cortas desde un origen que se repara localmente cuando cambia una tubería, en lugar de volver
+ * a ejecutar Dijkstra sobre toda la red:
+ *  - Si una tubería del árbol se deshabilita o se hace más lenta, solo el subárbol que colgaba de ella pierde su
+ *    ruta (al estilo de Ramalingam–Reps). Sus centros toman la mejor tubería entrante desde fuera del subárbol y
+ *    una búsqueda de Dijkstra limitada a ellos termina de repararlos.
+ *  - Si una tubería se habilita, se agrega o se hace más rápida, una onda de relajación parte de su destino y solo
+ *    avanza mientras mejora algún tiempo acumulado.
+ */
+class ArbolRutasDinamico {
+    private:
+        int centroAguaOrigen; // Origen del árbol
+        std::vector<int> minutosParaLlegarAcumulados; // Tiempo acumulado mínimo desde el origen
+        std::vector<int> centrosAguaPrevio; // Centro de agua previo en la ruta más corta
+        ColaPrioridadIndexada<> colaPrioridad; // Cola reutilizada en cada reparación
+        std::vector<int> afectados; // Centros del subárbol que perdió su ruta en la última reparación
+        std::vector<char> esAfectado; // Marca de pertenencia a afectados
+
+        /**
+         * Propaga las mejoras de los centros en la cola con una búsqueda de Dijkstra que solo avanza mientras
+         * encuentra tiempos acumulados menores.
+         */
+        void propagarMejoras(const RedCSR& red) {
+            while (!colaPrioridad.isEmpty()) {
+                int centroAguaActual = colaPrioridad.extraerMinimo();
+                for (int tuberia = red.inicioAdyacentes[centroAguaActual]; tuberia < red.inicioAdyacentes[centroAguaActual + 1]; ++tuberia) {
+                    if (!red.disponibles[tuberia]) {
+                        continue;
+                    }
+                    int centroAguaVecino = red.destinos[tuberia];
+                    int nuevosMinutosParaLlegar = minutosParaLlegarAcumulados[centroAguaActual] + red.minutos[tuberia];
+                    if (nuevosMinutosParaLlegar < minutosParaLlegarAcumulados[centroAguaVecino]) {
+                        minutosParaLlegarAcumulados[centroAguaVecino] = nuevosMinutosParaLlegar;
+                        centrosAguaPrevio[centroAguaVecino] = centroAguaActual;
+                        colaPrioridad.insertarODecrementar(centroAguaVecino, nuevosMinutosParaLlegar);
+                    }
+                }
+            }
+        }
+
+    public:
+        /**
+         * Construye el árbol ejecutando Dijkstra desde el origen.
+         *
+         * @param G Red de tuberías de agua.
+         * @param centroAguaOrigen Índice del centro de agua de origen.
+         */
+        ArbolRutasDinamico(Rutas& G, int centroAguaOrigen)
+            : centroAguaOrigen(centroAguaOrigen), colaPrioridad(G.getNumeroCentrosAgua()), esAfectado(G.getNumeroCentrosAgua(), 0) {
+            std::tie(minutosParaLlegarAcumulados, centrosAguaPrevio) = Dijkstra(G, centroAguaOrigen);
+        }
+
+        /**
+         * Construye el árbol a partir de un resultado de Dijkstra ya calculado (por ejemplo el del origen óptimo).
+         *
+         * @param centroAguaOrigen Índice del centro de agua de origen.
+         * @param minutosParaLlegarAcumulados Tiempos acumulados calculados por Dijkstra.
+         * @param centrosAguaPrevio Centros de agua previos calculados por Dijkstra.
+         */
+        ArbolRutasDinamico(int centroAguaOrigen, std::vector<int> minutosParaLlegarAcumulados, std::vector<int> centrosAguaPrevio)
+            : centroAguaOrigen(centroAguaOrigen),
+              minutosParaLlegarAcumulados(std::move(minutosParaLlegarAcumulados)),
+              centrosAguaPrevio(std::move(centrosAguaPrevio)),
+              colaPrioridad(static_cast<int>(this->minutosParaLlegarAcumulados.size())),
+              esAfectado(this->minutosParaLlegarAcumulados.size(), 0) {}
+
+        /**
+         * Obtiene el centro de agua de origen del árbol.
+         *
+         * @return Índice del origen.
+         */
+        int getOrigen() const {
+            return centroAguaOrigen;
+        }
+
+        /**
+         * Obtiene el tiempo acumulado mínimo desde el origen hacia cada centro de agua (INT_MAX si no hay camino).
+         *
+         * @return Vector de tiempos acumulados.
+         */
+        const std::vector<int>& getMinutosParaLlegarAcumulados() const {
+            return minutosParaLlegarAcumulados;
+        }
+
+        /**
+         * Obtiene el centro de agua previo de cada centro en su ruta más corta, para usar con reconstruirRuta.
+         *
+         * @return Vector de centros de agua previos.
+         */
+        const std::vector<int>& getCentrosAguaPrevio() const {
+            return centrosAguaPrevio;
+        }
+
+        /**
+         * Obtiene la cantidad de centros cuya ruta se perdió y se recalculó en la última reparación.
+         *
+         * @return Tamaño del subárbol afectado.
+         */
+        int getNumeroAfectados() const {
+            return static_cast<int>(afectados.size());
+        }
+
+        /**
+         * Repara el árbol después de que la tubería u -> v se deshabilitó o aumentó sus minutos.
+         * Si la tubería no forma parte del árbol ninguna ruta más corta cambia y no se hace nada.
+         *
+         * @param G Red de tuberías de agua, ya modificada.
+         * @param u Índice del centro de agua de origen de la tubería.
+         * @param v Índice del centro de agua de destino de la tubería.
+         */
+        void repararTrasEliminacion(Rutas& G, int u, int v) {
+            afectados.clear();
+            if (centrosAguaPrevio[v] != u) {
+                return;
+            }
+            const RedCSR& red = G.getRedCSR();
+            const RedInversaCSR& inversa = G.getRedInversaCSR();
+
+            // Recolectar el subárbol que colgaba de la tubería siguiendo las tuberías del árbol
+            afectados.push_back(v);
+            esAfectado[v] = 1;
+            for (size_t i = 0; i < afectados.size(); ++i) {
+                int x = afectados[i];
+                for (int tuberia = red.inicioAdyacentes[x]; tuberia < red.inicioAdyacentes[x + 1]; ++tuberia) {
+                    int y = red.destinos[tuberia];
+                    if (!esAfectado[y] && centrosAguaPrevio[y] == x) {
+                        esAfectado[y] = 1;
+                        afectados.push_back(y);
+                    }
+                }
+            }
+            for (int y : afectados) {
+                minutosParaLlegarAcumulados[y] = INT_MAX;
+                centrosAguaPrevio[y] = -1;
+            }
+
+            // Cada centro afectado toma la mejor tubería entrante desde un centro no afectado
+            for (int y : afectados) {
+                for (int posicion = inversa.inicioEntrantes[y]; posicion < inversa.inicioEntrantes[y + 1]; ++posicion) {
+                    int x = inversa.origenes[posicion];
+                    int tuberia = inversa.tuberias[posicion];
+                    if (!red.disponibles[tuberia] || esAfectado[x] || minutosParaLlegarAcumulados[x] == INT_MAX) {
+                        continue;
+                    }
+                    int candidato = minutosParaLlegarAcumulados[x] + red.minutos[tuberia];
+                    if (candidato < minutosParaLlegarAcumulados[y]) {
+                        minutosParaLlegarAcumulados[y] = candidato;
+                        centrosAguaPrevio[y] = x;
+                    }
+                }
+                if (minutosParaLlegarAcumulados[y] != INT_MAX) {
+                    colaPrioridad.insertar(y, minutosParaLlegarAcumulados[y]);
+                }
+            }
+            for (int y : afectados) {
+                esAfectado[y] = 0;
+            }
+
+            propagarMejoras(red);
+        }
+
+        /**
+         * Repara el árbol después de que la tubería u -> v se habilitó, se agregó o disminuyó sus minutos.
+         *
+         * @param G Red de tuberías de agua, ya modificada.
+         * @param u Índice del centro de agua de origen de la tubería.
+         * @param v Índice del centro de agua de destino de la tubería.
+         */
+        void repararTrasInsercion(Rutas& G, int u, int v) {
+            afectados.clear();
+            const RedCSR& red = G.getRedCSR();
+            int tuberia = red.buscarTuberia(u, v);
+            if (tuberia == -1 || !red.disponibles[tuberia] || minutosParaLlegarAcumulados[u] == INT_MAX) {
+                return;
+            }
+            int candidato = minutosParaLlegarAcumulados[u] + red.minutos[tuberia];
+            if (candidato < minutosParaLlegarAcumulados[v]) {
+                minutosParaLlegarAcumulados[v] = candidato;
+                centrosAguaPrevio[v] = u;
+                colaPrioridad.insertar(v, candidato);
+                propagarMejoras(red);
+            }
+        }
+};
+
+/**
+ * Clase RutasDinamicas
+ *
+ * Modo dinámico de la red: envuelve las operaciones de modificación de Rutas y mantiene al día los árboles de rutas
+ * de los orígenes que se siguen, reparando solo la parte afectada por cada cambio.
+ */
+class RutasDinamicas {
+    private:
+        Rutas& G; // Red de tuberías de agua
+        std::map<int, ArbolRutasDinamico> arboles; // Árboles de rutas por centro de agua de origen
+
+    public:
+        /**
+         * Constructor de la clase RutasDinamicas.
+         *
+         * @param G Red de tuberías de agua que se modificará a través de esta clase.
+         */
+        RutasDinamicas(Rutas& G) : G(G) {}
+
+        /**
+         * Empieza a seguir un origen calculando su árbol con Dijkstra (si aún no se seguía).
+         *
+         * @param centroAguaOrigen Índice del centro de agua de origen.
+         * @return El árbol de rutas del origen.
+         */
+        const ArbolRutasDinamico& seguirOrigen(int centroAguaOrigen) {
+            auto it = arboles.find(centroAguaOrigen);
+            if (it == arboles.end()) {
+                it = arboles.emplace(centroAguaOrigen, ArbolRutasDinamico(G, centroAguaOrigen)).first;
+            }
+            return it->second;
+        }
+
+        /**
+         * Empieza a seguir un origen con un árbol ya calculado, reemplazando el anterior si existía.
+         *
+         * @param centroAguaOrigen Índice del centro de agua de origen.
+         * @param minutosParaLlegarAcumulados Tiempos acumulados calculados por Dijkstra.
+         * @param centrosAguaPrevio Centros de agua previos calculados por Dijkstra.
+         * @return El árbol de rutas del origen.
+         */
+        const ArbolRutasDinamico& seguirOrigen(int centroAguaOrigen, std::vector<int> minutosParaLlegarAcumulados, std::vector<int> centrosAguaPrevio) {
+            arboles.erase(centroAguaOrigen);
+            return arboles.emplace(centroAguaOrigen, ArbolRutasDinamico(centroAguaOrigen, std::move(minutosParaLlegarAcumulados), std::move(centrosAguaPrevio))).first->second;
+        }
+
+        /**
+         * Deja de seguir un origen.
+         */
+        void dejarDeSeguir(int centroAguaOrigen) {
+            arboles.erase(centroAguaOrigen);
+        }
+
+        /**
+         * Obtiene el árbol de un origen seguido.
+         *
+         * @return Puntero al árbol, o nullptr si el origen no se sigue.
+         */
+        const ArbolRutasDinamico* getArbol(int centroAguaOrigen) const {
+            auto it = arboles.find(centroAguaOrigen);
+            return it == arboles.end() ? nullptr : &it->second;
+        }
+
+        /**
+         * Obtiene todos los árboles seguidos, por centro de agua de origen.
+         */
+        const std::map<int, ArbolRutasDinamico>& getArboles() const {
+            return arboles;
+        }
+
+        /**
+         * Agrega o actualiza una tubería y repara los árboles seguidos.
+         *
+         * @param u Índice del centro de agua de origen.
+         * @param v Índice del centro de agua de destino.
+         * @param tiempoParaLlegar Tiempo de viaje a través de la tubería.
+         * @param disponibilidad Estado de disponibilidad de la tubería.
+         */
+        void agregarTuberia(int u, int v, int tiempoParaLlegar, bool disponibilidad = true) {
+            const RedCSR& red = G.getRedCSR();
+            int tuberia = red.buscarTuberia(u, v);
+            // La tubería anterior empeora si deja de estar disponible o se hace más lenta
+            bool empeora = tuberia != -1 && red.disponibles[tuberia] && (!disponibilidad || tiempoParaLlegar > red.minutos[tuberia]);
+
+            G.agregarTuberia(u, v, tiempoParaLlegar, disponibilidad);
+            for (auto& [origen, arbol] : arboles) {
+                if (empeora) {
+                    arbol.repararTrasEliminacion(G, u, v);
+                }
+                arbol.repararTrasInsercion(G, u, v);
+            }
+        }
+
+        /**
+         * Establece la disponibilidad de una tubería y repara los árboles seguidos.
+         *
+         * @param u Índice del centro de agua de origen.
+         * @param v Índice del centro de agua de destino.
+         * @param disponibilidad Nuevo estado de disponibilidad para la tubería.
+         * @return false si la tubería no existe (los árboles no cambian).
+         */
+        bool establecerDisponibilidad(int u, int v, bool disponibilidad) {
+            if (!G.establecerDisponibilidad(u, v, disponibilidad)) {
+                return false;
+            }
+            for (auto& [origen, arbol] : arboles) {
+                if (disponibilidad) {
+                    arbol.repararTrasInsercion(G, u, v);
+                } else {
+                    arbol.repararTrasEliminacion(G, u, v);
+                }
+            }
+            return true;
+        }
+};
+
+#endif // RUTAS_DINAMICAS_H
@@ -0,0 +1,64 @@
+#ifndef TIPOS_RED_H
+#define TIPOS_RED_H
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/*Tipos con los que se guarda una red: el índice de los centros de agua, los minutos de cada tubería y los minutos
+  acumulados de una ruta. Rutas, su instantánea CSR, EspacioDijkstra y reconstruirRuta reciben estos tipos como
+  parámetro de plantilla; los nombres de siempre (Rutas, RedCSR, EspacioDijkstra) usan int en los tres, como antes.
+
+  TiposRedCompactos guarda los minutos de cada tubería en 16 bits (la instantánea ocupa tres cuartos que con int) y
+  TiposRedPequenos además los destinos, para redes de hasta 65535 centros (la mitad); así entra más de la red en la
+  caché. TiposRedAmplios acumula en 64 bits para redes donde una ruta puede pasar de 2^31 minutos.
+
+  Los centinelas son constexpr: sinCamino (minutos acumulados de un centro sin ruta) es el mayor valor de Distancia,
+  y sinCentro (previo del origen o de un centro sin ruta) es -1 con índices con signo y el mayor valor sin signo. Las
+  sumas de minutos se saturan en sinCamino: una ruta que no cabe en Distancia cuenta como inexistente en lugar de
+  dar la vuelta. */
+
+/**
+ * Centro que indica "ningún centro" para un tipo de índice: -1 con signo, el mayor valor sin signo.
+ */
+template <typename Centro>
+constexpr Centro centroNulo() {
+    return std::is_signed<Centro>::value ? static_cast<Centro>(-1) : std::numeric_limits<Centro>::max();
+}
+
+/**
+ * Estructura TiposRed
+ *
+ * Tipos de una red y sus centinelas.
+ *
+ * @tparam CentroT Índice de un centro de agua (entero de al menos 16 bits).
+ * @tparam MinutosT Minutos de una tubería (entero no negativo).
+ * @tparam DistanciaT Minutos acumulados de una ruta (entero al menos tan ancho como MinutosT).
+ */
+template <typename CentroT, typename MinutosT, typename DistanciaT>
+struct TiposRed {
+    static_assert(std::is_integral<CentroT>::value && sizeof(CentroT) >= 2, "Los centros necesitan un entero de al menos 16 bits");
+    static_assert(std::is_integral<MinutosT>::value && std::is_integral<DistanciaT>::value, "Los minutos deben ser enteros");
+    static_assert(sizeof(DistanciaT) >= sizeof(MinutosT), "Los minutos acumulados deben caber en Distancia");
+
+    using Centro = CentroT;
+    using Minutos = MinutosT;
+    using Distancia = DistanciaT;
+
+    static constexpr Distancia sinCamino = std::numeric_limits<Distancia>::max(); // Minutos acumulados de un centro sin ruta
+    static constexpr Centro sinCentro = centroNulo<Centro>(); // Previo del origen y de los centros sin ruta
+
+    /**
+     * Suma los minutos de una tubería a unos minutos acumulados, saturando en sinCamino.
+     */
+    static constexpr Distancia sumarMinutos(Distancia distancia, Minutos minutos) {
+        return distancia > sinCamino - static_cast<Distancia>(minutos) ? sinCamino : static_cast<Distancia>(distancia + minutos);
+    }
+};
+
+using TiposRedPredeterminados = TiposRed<int, int, int>; // Los de siempre: sinCamino es INT_MAX y sinCentro es -1
+using TiposRedCompactos = TiposRed<std::uint32_t, std::uint16_t, std::uint32_t>; // Tuberías de hasta 65535 minutos
+using TiposRedPequenos = TiposRed<std::uint16_t, std::uint16_t, std::uint32_t>; // Además, hasta 65535 centros
+using TiposRedAmplios = TiposRed<std::uint32_t, std::uint32_t, std::uint64_t>; // Rutas de más de 2^31 minutos
+
+#endif // TIPOS_RED_H
@@ -0,0 +1,178 @@
+#ifndef TODOS_ORIGENES_H
+#define TODOS_ORIGENES_H
+
+#include <vector>
+#include <climits>
+#include "rutas.h"
+#include "cola_prioridad.h"
+#include "dijkstra.h"
+#include "pool_hilos.h"
+#include "matriz_distancias.h"
+#include "instrumentacion.h"
+
+/**
+ * Estructura ResumenOrigen
+ *
+ * Resumen de las rutas más cortas desde un centro de agua de origen hacia el resto de la red.
+ */
+struct ResumenOrigen {
+    long long minutosTotales = 0; // Suma de los minutos hacia los centros alcanzables
+    int minutosMaximo = 0; // Mayor tiempo hacia un centro alcanzable
+    int centrosInalcanzables = 0; // Cantidad de centros sin camino desde el origen
+    long long relajaciones = 0; // Tuberías relajadas por la búsqueda desde el origen
+};
+
+/**
+ * Estructura ResultadoTodosOrigenes
+ *
+ * Resultado del cálculo desde todos los orígenes: el resumen de cada origen y el árbol de rutas completo del
+ * origen óptimo, para no tener que volver a ejecutar Dijkstra sobre él.
+ */
+struct ResultadoTodosOrigenes {
+    std::vector<ResumenOrigen> resumenes; // Resumen de cada centro de agua como origen
+    int origenOptimo = -1; // Centro de agua con menos centros inalcanzables y, a igualdad, menos minutos totales
+    std::vector<int> minutosOrigenOptimo; // Tiempos acumulados desde el origen óptimo
+    std::vector<int> previoOrigenOptimo; // Centros de agua previos en las rutas desde el origen óptimo
+};
+
+/**
+ * Compara dos orígenes: es mejor el que deja menos centros sin abastecer y, a igualdad, el de menos minutos totales.
+ * Los empates se resuelven por el índice menor para que el resultado no dependa del reparto entre hilos.
+ */
+bool esMejorOrigen(const ResumenOrigen& a, int origenA, const ResumenOrigen& b, int origenB) {
+    if (a.centrosInalcanzables != b.centrosInalcanzables) {
+        return a.centrosInalcanzables < b.centrosInalcanzables;
+    }
+    if (a.minutosTotales != b.minutosTotales) {
+        return a.minutosTotales < b.minutosTotales;
+    }
+    return origenA < origenB;
+}
+
+/**
+ * Ejecuta Dijkstra desde cada centro de agua en paralelo y elige el origen óptimo.
+ * Es la variante para redes dispersas; calcularTodosOrigenes elige entre esta y la matriz de distancias.
+ *
+ * Cada hilo del pool tiene su propio EspacioDijkstra, además de su mejor origen local con su árbol de rutas. El resumen
+ * de cada origen recorre solo los centros alcanzados, y el árbol se copia únicamente cuando el origen mejora al mejor
+ * local, así que después de la primera búsqueda los hilos no piden memoria. Los hilos no comparten estado mutable: al
+ * final se reducen los mejores locales.
+ *
+ * @param G Red de tuberías de agua.
+ * @param pool Pool de hilos que reparte los orígenes.
+ * @return Resúmenes por origen y árbol de rutas del origen óptimo.
+ */
+ResultadoTodosOrigenes calcularTodosOrigenesDijkstra(Rutas& G, PoolHilos& pool) {
+    INSTRUMENTAR_FASE(FaseTodosOrigenes);
+    // Buffers propios de cada hilo
+    struct alignas(64) EspacioHilo {
+        EspacioDijkstra busqueda;
+        int mejorOrigen = -1;
+        std::vector<int> mejoresMinutos;
+        std::vector<int> mejorPrevio;
+
+        EspacioHilo(int numeroCentrosAgua, int minutosMaximo) : busqueda(numeroCentrosAgua, minutosMaximo) {
+            mejoresMinutos.reserve(numeroCentrosAgua);
+            mejorPrevio.reserve(numeroCentrosAgua);
+        }
+    };
+
+    int numeroCentrosAgua = G.getNumeroCentrosAgua();
+    const RedCSR& red = G.getRedCSR();
+    ResultadoTodosOrigenes resultado;
+    resultado.resumenes.resize(numeroCentrosAgua);
+
+    std::vector<EspacioHilo> espacios;
+    espacios.reserve(pool.getNumeroHilos());
+    for (int hilo = 0; hilo < pool.getNumeroHilos(); ++hilo) {
+        espacios.emplace_back(numeroCentrosAgua, G.getMinutosMaximo());
+    }
+
+    pool.paraCada(numeroCentrosAgua, [&](int hilo, int origen) {
+        EspacioHilo& espacio = espacios[hilo];
+        ResumenOrigen resumen;
+        resumen.relajaciones = espacio.busqueda.ejecutar(red, origen);
+        const std::vector<int>& alcanzados = espacio.busqueda.getAsentados();
+        for (int destino : alcanzados) {
+            resumen.minutosTotales += espacio.busqueda.getMinutos(destino);
+        }
+        resumen.minutosMaximo = espacio.busqueda.getMinutos(alcanzados.back()); // Los asentados salen en orden creciente
+        resumen.centrosInalcanzables = numeroCentrosAgua - static_cast<int>(alcanzados.size());
+        resultado.resumenes[origen] = resumen; // Cada origen escribe solo su propia posición
+
+        if (espacio.mejorOrigen == -1 || esMejorOrigen(resumen, origen, resultado.resumenes[espacio.mejorOrigen], espacio.mejorOrigen)) {
+            espacio.mejorOrigen = origen;
+            espacio.busqueda.copiarResultado(espacio.mejoresMinutos, espacio.mejorPrevio); // Conservar el árbol en memoria ya reservada
+        }
+    });
+
+    // Reducir los mejores orígenes de cada hilo
+    for (EspacioHilo& espacio : espacios) {
+        if (espacio.mejorOrigen == -1) {
+            continue;
+        }
+        if (resultado.origenOptimo == -1 || esMejorOrigen(resultado.resumenes[espacio.mejorOrigen], espacio.mejorOrigen,
+                                                          resultado.resumenes[resultado.origenOptimo], resultado.origenOptimo)) {
+            resultado.origenOptimo = espacio.mejorOrigen;
+            resultado.minutosOrigenOptimo.swap(espacio.mejoresMinutos);
+            resultado.previoOrigenOptimo.swap(espacio.mejorPrevio);
+        }
+    }
+    return resultado;
+}
+
+/**
+ * Calcula el resumen de cada origen con la matriz de distancias (ver matriz_distancias.h): los minutos totales, el
+ * máximo y los centros sin camino de cada origen salen de recorrer su fila, y el árbol del origen óptimo es su fila
+ * de minutos y de previos. No hay relajaciones que contar.
+ *
+ * @param G Red de tuberías de agua.
+ * @param pool Pool de hilos que reparte los bloques de la matriz y las filas.
+ * @return Resúmenes por origen y árbol de rutas del origen óptimo.
+ */
+ResultadoTodosOrigenes calcularTodosOrigenesMatriz(Rutas& G, PoolHilos& pool) {
+    INSTRUMENTAR_FASE(FaseTodosOrigenes);
+    int numeroCentrosAgua = G.getNumeroCentrosAgua();
+    MatrizDistancias matriz;
+    matriz.construir(G.getRedCSR(), pool);
+
+    ResultadoTodosOrigenes resultado;
+    resultado.resumenes.resize(numeroCentrosAgua);
+    pool.paraCada(numeroCentrosAgua, [&](int, int origen) {
+        ResumenOrigen& resumen = resultado.resumenes[origen];
+        for (int destino = 0; destino < numeroCentrosAgua; ++destino) {
+            int minutos = matriz.getMinutos(origen, destino);
+            if (minutos == INT_MAX) {
+                resumen.centrosInalcanzables++;
+            } else {
+                resumen.minutosTotales += minutos;
+                resumen.minutosMaximo = std::max(resumen.minutosMaximo, minutos);
+            }
+        }
+    });
+    for (int origen = 0; origen < numeroCentrosAgua; ++origen) {
+        if (resultado.origenOptimo == -1 || esMejorOrigen(resultado.resumenes[origen], origen,
+                                                          resultado.resumenes[resultado.origenOptimo], resultado.origenOptimo)) {
+            resultado.origenOptimo = origen;
+        }
+    }
+    matriz.copiarFila(resultado.origenOptimo, resultado.minutosOrigenOptimo, resultado.previoOrigenOptimo);
+    return resultado;
+}
+
+/**
+ * Calcula el resumen de cada origen y el origen óptimo (opción 6). En subredes densas de unos pocos miles de centros
+ * usa la matriz de distancias; en el resto, una búsqueda de Dijkstra por origen (ver MatrizDistancias::convieneMatriz).
+ *
+ * @param G Red de tuberías de agua.
+ * @param pool Pool de hilos.
+ * @return Resúmenes por origen y árbol de rutas del origen óptimo.
+ */
+ResultadoTodosOrigenes calcularTodosOrigenes(Rutas& G, PoolHilos& pool) {
+    if (MatrizDistancias::convieneMatriz(G.getRedCSR())) {
+        return calcularTodosOrigenesMatriz(G, pool);
+    }
+    return calcularTodosOrigenesDijkstra(G, pool);
+}
+
+#endif // TODOS_ORIGENES_H
@@ -0,0 +1,238 @@
+#ifndef VISUALIZADOR_PYTHON_H
+#define VISUALIZADOR_PYTHON_H
+
+/*Visualización en Python (graph_script.py) como consumidor asíncrono y opcional del motor de rutas.
+  Las modificaciones de la red se encolan y un hilo propio las entrega a Python por lotes; ese hilo es el único que
+  inicializa y usa el intérprete, así que un dibujo que bloquea en plt.show() no detiene el menú ni los cálculos.
+  Compilando con -DSIN_PYTHON la clase queda vacía y el programa no necesita Python.h ni la biblioteca de Python. */
+
+#ifndef SIN_PYTHON
+#include <C:\Users\mauri\AppData\Local\Programs\Python\Python311\include\Python.h> // Asegúrate de que la ruta de la cabecera sea correcta
+#endif
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+/**
+ * Estructura EventoVisualizacion
+ *
+ * Cambio o pedido de dibujo pendiente de entregar a Python.
+ */
+struct EventoVisualizacion {
+    enum Tipo { AgregarTuberia, Deshabilitar, Habilitar, InicializarRutas, MostrarRutas };
+    Tipo tipo;
+    int u = 0;
+    int v = 0;
+    int minutos = 0;
+};
+
+#ifndef SIN_PYTHON
+
+/**
+ * Clase VisualizadorPython
+ *
+ * Cola de eventos de visualización vaciada por un hilo que mantiene el intérprete de Python. Los cambios consecutivos
+ * se envían en una sola llamada a aplicar_cambios; los dibujos (inicializar_rutas, mostrar_rutas) se ejecutan en
+ * orden después de los cambios anteriores a ellos.
+ */
+class VisualizadorPython {
+    private:
+        enum Estado { Cargando, Disponible, NoDisponible };
+
+        std::thread hilo; // Hilo dueño del intérprete de Python
+        std::mutex cerrojo; // Protege eventos y detener
+        std::condition_variable hayEventos; // Avisa al hilo de que hay eventos o de que debe terminar
+        std::vector<EventoVisualizacion> eventos; // Eventos pendientes
+        bool detener = false; // Indica al hilo que debe terminar
+        std::atomic<int> estado{Cargando}; // Estado de la carga de graph_script
+
+        /**
+         * Llama a una función de graph_script y opcionalmente imprime el texto que devuelve.
+         * Libera los argumentos recibidos.
+         */
+        static void llamarFuncion(PyObject* modulo, const char* nombreFuncion, PyObject* argumentos, bool mostrarResultado) {
+            PyObject* funcion = PyObject_GetAttrString(modulo, nombreFuncion);
+            if (funcion && PyCallable_Check(funcion)) {
+                PyObject* valor = PyObject_CallObject(funcion, argumentos);
+                if (valor != nullptr) {
+                    const char* resultado = PyUnicode_Check(valor) ? PyUnicode_AsUTF8(valor) : nullptr;
+                    if (mostrarResultado && resultado != nullptr) {
+                        std::cout << resultado << std::endl;
+                    }
+                    Py_DECREF(valor);
+                } else {
+                    PyErr_Print();
+                    std::cerr << "Llamada a la función " << nombreFuncion << " fallida" << std::endl;
+                }
+            } else {
+                if (PyErr_Occurred()) {
+                    PyErr_Print();
+                }
+                std::cerr << "No se pudo encontrar la función " << nombreFuncion << std::endl;
+            }
+            Py_XDECREF(funcion);
+            Py_XDECREF(argumentos);
+        }
+
+        /**
+         * Envía a Python los cambios acumulados en una sola llamada a aplicar_cambios.
+         */
+        static void enviarCambios(PyObject* modulo, std::vector<const EventoVisualizacion*>& cambios) {
+            if (cambios.empty()) {
+                return;
+            }
+            PyObject* lista = PyList_New(static_cast<Py_ssize_t>(cambios.size()));
+            for (size_t i = 0; i < cambios.size(); ++i) {
+                const EventoVisualizacion& evento = *cambios[i];
+                const char* tipo = evento.tipo == EventoVisualizacion::AgregarTuberia ? "agregar"
+                                 : evento.tipo == EventoVisualizacion::Deshabilitar ? "deshabilitar" : "habilitar";
+                PyList_SET_ITEM(lista, static_cast<Py_ssize_t>(i), Py_BuildValue("(siii)", tipo, evento.u, evento.v, evento.minutos));
+            }
+            llamarFuncion(modulo, "aplicar_cambios", PyTuple_Pack(1, lista), false);
+            Py_DECREF(lista);
+            cambios.clear();
+        }
+
+        /**
+         * Entrega un lote de eventos a Python. Al terminar el programa se aplican los cambios pero se omiten los dibujos.
+         */
+        static void procesarLote(PyObject* modulo, const std::vector<EventoVisualizacion>& lote, bool omitirDibujos) {
+            std::vector<const EventoVisualizacion*> cambios;
+            for (const EventoVisualizacion& evento : lote) {
+                if (evento.tipo == EventoVisualizacion::InicializarRutas || evento.tipo == EventoVisualizacion::MostrarRutas) {
+                    enviarCambios(modulo, cambios);
+                    if (!omitirDibujos) {
+                        llamarFuncion(modulo, evento.tipo == EventoVisualizacion::InicializarRutas ? "inicializar_rutas" : "mostrar_rutas", nullptr, true);
+                    }
+                } else {
+                    cambios.push_back(&evento);
+                }
+            }
+            enviarCambios(modulo, cambios);
+        }
+
+        /**
+         * Bucle del hilo: inicializa Python, carga graph_script y entrega los eventos hasta que se pida terminar.
+         */
+        void trabajar() {
+            Py_Initialize();
+            PyObject* nombre = PyUnicode_DecodeFSDefault("graph_script");
+            PyObject* modulo = PyImport_Import(nombre);
+            Py_DECREF(nombre);
+            if (modulo == nullptr) {
+                PyErr_Print();
+                std::cerr << "No se pudo cargar el módulo graph_script; la visualización queda desactivada" << std::endl;
+            }
+            estado = modulo != nullptr ? Disponible : NoDisponible;
+
+            std::vector<EventoVisualizacion> lote;
+            while (true) {
+                bool terminando;
+                {
+                    std::unique_lock<std::mutex> guardia(cerrojo);
+                    hayEventos.wait(guardia, [&] { return detener || !eventos.empty(); });
+                    if (eventos.empty()) {
+                        break;
+                    }
+                    lote.swap(eventos);
+                    terminando = detener;
+                }
+                if (modulo != nullptr) {
+                    procesarLote(modulo, lote, terminando);
+                }
+                lote.clear();
+            }
+
+            Py_XDECREF(modulo);
+            Py_Finalize();
+        }
+
+        /**
+         * Agrega un evento a la cola, salvo que graph_script no se haya podido cargar.
+         */
+        void encolar(const EventoVisualizacion& evento) {
+            if (estado == NoDisponible) {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> guardia(cerrojo);
+                eventos.push_back(evento);
+            }
+            hayEventos.notify_one();
+        }
+
+    public:
+        /**
+         * Constructor de la clase VisualizadorPython: lanza el hilo que inicializa Python y carga graph_script.
+         */
+        VisualizadorPython() : hilo(&VisualizadorPython::trabajar, this) {}
+
+        VisualizadorPython(const VisualizadorPython&) = delete;
+        VisualizadorPython& operator=(const VisualizadorPython&) = delete;
+
+        /**
+         * Entrega los cambios pendientes, finaliza Python y espera al hilo.
+         */
+        ~VisualizadorPython() {
+            {
+                std::lock_guard<std::mutex> guardia(cerrojo);
+                detener = true;
+            }
+            hayEventos.notify_one();
+            hilo.join();
+        }
+
+        /**
+         * Indica si la visualización está disponible (falso si graph_script no se pudo cargar).
+         */
+        bool estaDisponible() const {
+            return estado != NoDisponible;
+        }
+
+        void inicializarRutas() {
+            encolar({EventoVisualizacion::InicializarRutas});
+        }
+
+        void mostrarRutas() {
+            encolar({EventoVisualizacion::MostrarRutas});
+        }
+
+        void agregarTuberia(int u, int v, int minutos) {
+            encolar({EventoVisualizacion::AgregarTuberia, u, v, minutos});
+        }
+
+        void establecerDisponibilidad(int u, int v, bool disponibilidad) {
+            encolar({disponibilidad ? EventoVisualizacion::Habilitar : EventoVisualizacion::Deshabilitar, u, v, 0});
+        }
+};
+
+#else
+
+/**
+ * Clase VisualizadorPython (compilación con -DSIN_PYTHON)
+ *
+ * Misma interfaz sin efecto: el programa funciona sin el intérprete y la red se visualiza con exportar_red.h.
+ */
+class VisualizadorPython {
+    public:
+        bool estaDisponible() const {
+            return false;
+        }
+
+        void inicializarRutas() {}
+
+        void mostrarRutas() {}
+
+        void agregarTuberia(int, int, int) {}
+
+        void establecerDisponibilidad(int, int, bool) {}
+};
+
+#endif // SIN_PYTHON
+
+#endif // VISUALIZADOR_PYTHON_H